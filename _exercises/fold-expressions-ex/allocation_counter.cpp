@@ -0,0 +1,116 @@
+#include "allocation_counter.hpp"
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    void* counted_malloc(size_t size) noexcept
+    {
+        ++AllocationCounter::allocations;
+
+        return std::malloc(size ? size : 1);
+    }
+
+    void* counted_aligned_alloc(size_t size, std::align_val_t alignment) noexcept
+    {
+        ++AllocationCounter::allocations;
+
+        const size_t align = static_cast<size_t>(alignment);
+        return std::aligned_alloc(align, (size + align - 1) / align * align);
+    }
+
+    void counted_free(void* ptr) noexcept
+    {
+        if (ptr)
+            ++AllocationCounter::deallocations;
+
+        std::free(ptr);
+    }
+}
+
+void* operator new(size_t size)
+{
+    if (void* ptr = counted_malloc(size))
+        return ptr;
+
+    throw std::bad_alloc{};
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return counted_malloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return counted_malloc(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    if (void* ptr = counted_aligned_alloc(size, alignment))
+        return ptr;
+
+    throw std::bad_alloc{};
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return counted_aligned_alloc(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return counted_aligned_alloc(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    counted_free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    counted_free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    counted_free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+    counted_free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+    counted_free(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept
+{
+    counted_free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+    counted_free(ptr);
+}
+
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept
+{
+    counted_free(ptr);
+}
@@ -0,0 +1,14 @@
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+#include <cstddef>
+
+// counters of heap allocations and deallocations;
+// updated by the global operator new/delete replacement in allocation_counter.cpp
+namespace AllocationCounter
+{
+    inline size_t allocations{};
+    inline size_t deallocations{};
+}
+
+#endif
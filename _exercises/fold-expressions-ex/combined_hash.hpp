@@ -0,0 +1,233 @@
+#ifndef COMBINED_HASH_HPP
+#define COMBINED_HASH_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace Hash64
+{
+    constexpr uint64_t seed = 0x9E3779B97F4A7C15ULL;
+
+    // moremur-style finalizer - full avalanche of all 64 bits, no branches
+    constexpr uint64_t mix(uint64_t x) noexcept
+    {
+        x ^= x >> 27;
+        x *= 0x3C79AC492BA7B653ULL;
+        x ^= x >> 33;
+        x *= 0x1C69B3F74AC4AE35ULL;
+        x ^= x >> 27;
+        return x;
+    }
+
+    // values hashed without std::hash, or with a std::hash that doesn't throw
+    template <typename T>
+    constexpr bool is_nothrow_hashable_v = std::is_arithmetic_v<T> || std::is_enum_v<T>
+        || std::is_convertible_v<const T&, std::string_view> || std::is_nothrow_invocable_v<std::hash<T>, const T&>;
+
+    class HashState
+    {
+        static constexpr uint64_t multiplier = 0xD6E8FEB86659FD93ULL;
+
+        uint64_t state_ = seed;
+
+        // cheap injective step per word - avalanche is provided once by mix() in digest()
+        constexpr void update_word(uint64_t word) noexcept
+        {
+            state_ = ((state_ << 23 | state_ >> 41) ^ word) * multiplier;
+        }
+
+        // little-endian assembly of bytes - usable in constant expressions,
+        // compilers fold the full-word expression into a single load
+        static constexpr uint64_t byte_at(const char* ptr, size_t index) noexcept
+        {
+            return uint64_t{static_cast<unsigned char>(ptr[index])} << (8 * index);
+        }
+
+        static constexpr uint64_t load_word(const char* ptr) noexcept
+        {
+            return byte_at(ptr, 0) | byte_at(ptr, 1) | byte_at(ptr, 2) | byte_at(ptr, 3)
+                | byte_at(ptr, 4) | byte_at(ptr, 5) | byte_at(ptr, 6) | byte_at(ptr, 7);
+        }
+
+        static constexpr uint64_t load_tail(const char* ptr, size_t size) noexcept
+        {
+            uint64_t word{};
+            for (size_t i = 0; i < size; ++i)
+                word |= byte_at(ptr, i);
+
+            return word;
+        }
+
+        constexpr void update_bytes(std::string_view bytes) noexcept
+        {
+            const char* ptr = bytes.data();
+            size_t size = bytes.size();
+
+            for (; size >= 8; ptr += 8, size -= 8)
+                update_word(load_word(ptr));
+
+            update_word(load_tail(ptr, size) ^ (uint64_t{bytes.size()} << 56));
+        }
+
+    public:
+        constexpr HashState() = default;
+
+        constexpr explicit HashState(uint64_t initial_seed) noexcept
+            : state_{mix(initial_seed ^ seed)}
+        {
+        }
+
+        // integral, enum and string-like values can be hashed in constant expressions
+        template <typename T>
+        constexpr HashState& update(const T& value) noexcept(is_nothrow_hashable_v<T>)
+        {
+            if constexpr (std::is_integral_v<T> || std::is_enum_v<T>)
+            {
+                update_word(static_cast<uint64_t>(value));
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                const double normalized = (value == 0) ? 0.0 : static_cast<double>(value); // -0.0 == 0.0
+                uint64_t bits;
+                std::memcpy(&bits, &normalized, sizeof(bits));
+                update_word(bits);
+            }
+            else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+            {
+                update_bytes(std::string_view{value});
+            }
+            else
+            {
+                update_word(std::hash<T>{}(value));
+            }
+
+            return *this;
+        }
+
+        template <typename... TArgs>
+        constexpr HashState& update_all(const TArgs&... args) noexcept((... && is_nothrow_hashable_v<TArgs>))
+        {
+            (..., update(args));
+            return *this;
+        }
+
+        constexpr uint64_t digest() const noexcept
+        {
+            return mix(state_);
+        }
+    };
+
+    template <typename... TArgs>
+    constexpr uint64_t combined_hash(const TArgs&... args) noexcept((... && is_nothrow_hashable_v<TArgs>))
+    {
+        HashState state;
+        state.update_all(args...);
+        return state.digest();
+    }
+
+    // hashes [first, last) of tuples into out - iterations are independent, so the mixers of
+    // consecutive tuples overlap in the pipeline
+    template <typename TIterator, typename TOutIterator>
+    TOutIterator combined_hash_batch(TIterator first, TIterator last, TOutIterator out)
+    {
+        for (; first != last; ++first, ++out)
+        {
+            *out = std::apply([](const auto&... args) { return combined_hash(args...); }, *first);
+        }
+
+        return out;
+    }
+
+    // drop-in hasher for unordered containers keyed by tuples
+    struct TupleHash
+    {
+        template <typename... Ts>
+        size_t operator()(const std::tuple<Ts...>& key) const noexcept((... && is_nothrow_hashable_v<Ts>))
+        {
+            return static_cast<size_t>(std::apply([](const auto&... args) { return combined_hash(args...); }, key));
+        }
+    };
+
+    // perfect-hash table over precomputed key hashes, built at compile time:
+    // a salt is searched until every key lands in its own slot, so lookup is one probe
+    template <typename TValue, size_t N>
+    class StaticHashMap
+    {
+        static constexpr size_t table_size = [] {
+            size_t size = 1;
+            while (size < 2 * N)
+                size *= 2;
+            return size;
+        }();
+
+        struct Slot
+        {
+            uint64_t key_hash{};
+            TValue value{};
+            bool occupied{};
+        };
+
+        std::array<Slot, table_size> slots_{};
+        uint64_t salt_{};
+
+        static constexpr size_t slot_index(uint64_t key_hash, uint64_t salt) noexcept
+        {
+            return static_cast<size_t>(mix(key_hash ^ salt)) & (table_size - 1);
+        }
+
+        constexpr bool try_build(const std::array<std::pair<uint64_t, TValue>, N>& items, uint64_t salt)
+        {
+            slots_ = {};
+
+            for (const auto& [key_hash, value] : items)
+            {
+                Slot& slot = slots_[slot_index(key_hash, salt)];
+
+                if (slot.occupied)
+                    return false;
+
+                slot = Slot{key_hash, value, true};
+            }
+
+            salt_ = salt;
+            return true;
+        }
+
+    public:
+        // throws std::invalid_argument for duplicate key hashes - no salt could separate them
+        constexpr explicit StaticHashMap(const std::array<std::pair<uint64_t, TValue>, N>& items)
+        {
+            for (size_t i = 0; i < N; ++i)
+                for (size_t j = i + 1; j < N; ++j)
+                    if (items[i].first == items[j].first)
+                        throw std::invalid_argument{"duplicate key hash"};
+
+            uint64_t salt{};
+            while (!try_build(items, salt))
+                ++salt;
+        }
+
+        // keys are identified by their 64-bit hash only
+        constexpr const TValue* find(uint64_t key_hash) const noexcept
+        {
+            const Slot& slot = slots_[slot_index(key_hash, salt_)];
+            return (slot.occupied && slot.key_hash == key_hash) ? &slot.value : nullptr;
+        }
+
+        template <typename... TArgs>
+        constexpr const TValue* find_key(const TArgs&... args) const noexcept((... && is_nothrow_hashable_v<TArgs>))
+        {
+            return find(combined_hash(args...));
+        }
+    };
+}
+
+#endif
@@ -1,14 +1,34 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "allocation_counter.hpp"
+#include "combined_hash.hpp"
+#include "small_vector.hpp"
+
 #include <algorithm>
+#include <bitset>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cstdint>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <random>
 #include <set>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#define FOLD_EX_HAS_SSE2 1
+#include <emmintrin.h>
+#endif
+
 using namespace std;
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -25,7 +45,157 @@ int matches(const TVec& v, const TArgs&... args)
 template <typename TVec, typename... TArgs>
 int matches_alt(const TVec& v, const TArgs&... args)
 {
-    return (... + count(begin(v), end(v), args)));
+    return (... + count(begin(v), end(v), args));
+}
+
+namespace Detail
+{
+    template <typename TContainer, typename = void>
+    constexpr bool is_contiguous_v = std::is_array_v<TContainer>;
+
+    template <typename TContainer>
+    constexpr bool is_contiguous_v<TContainer, std::void_t<decltype(std::data(std::declval<const TContainer&>()))>> = true;
+
+    template <typename TValue, typename... TArgs>
+    size_t count_matches_scalar(const TValue* items, size_t size, const TArgs&... args)
+    {
+        size_t num{0};
+        for (size_t i = 0; i < size; ++i)
+        {
+            const TValue item = items[i];
+            num += (... + static_cast<size_t>(item == args));
+        }
+
+        return num;
+    }
+
+#ifdef FOLD_EX_HAS_SSE2
+    template <typename TValue>
+    constexpr bool has_sse2_lanes_v = (std::is_integral_v<TValue> && !std::is_same_v<TValue, bool>)
+        || std::is_same_v<TValue, float> || std::is_same_v<TValue, double>;
+
+    // unsigned lane counter as wide as the compared values
+    template <size_t Width>
+    using LaneCounter = std::conditional_t<Width == 1, uint8_t, std::conditional_t<Width == 2, uint16_t, std::conditional_t<Width == 4, uint32_t, uint64_t>>>;
+
+    // every arg may add one to a lane counter per iteration - at least one iteration must fit in a counter
+    template <typename TValue, size_t ArgCount>
+    constexpr bool fits_lane_counter_v = ArgCount <= std::numeric_limits<LaneCounter<sizeof(TValue)>>::max();
+
+    // lane-wise ==: -1 in every lane (of sizeof(TValue) bytes) that matches
+    template <typename TValue>
+    __m128i equal_lanes(__m128i block, __m128i needle)
+    {
+        if constexpr (std::is_same_v<TValue, float>)
+            return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(block), _mm_castsi128_ps(needle)));
+        else if constexpr (std::is_same_v<TValue, double>)
+            return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(block), _mm_castsi128_pd(needle)));
+        else if constexpr (sizeof(TValue) == 1)
+            return _mm_cmpeq_epi8(block, needle);
+        else if constexpr (sizeof(TValue) == 2)
+            return _mm_cmpeq_epi16(block, needle);
+        else if constexpr (sizeof(TValue) == 4)
+            return _mm_cmpeq_epi32(block, needle);
+        else
+        {
+            // no 64-bit compare in SSE2 - both 32-bit halves must match
+            const __m128i halves = _mm_cmpeq_epi32(block, needle);
+            return _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+        }
+    }
+
+    template <size_t Width>
+    __m128i subtract_lanes(__m128i counters, __m128i mask)
+    {
+        if constexpr (Width == 1)
+            return _mm_sub_epi8(counters, mask);
+        else if constexpr (Width == 2)
+            return _mm_sub_epi16(counters, mask);
+        else if constexpr (Width == 4)
+            return _mm_sub_epi32(counters, mask);
+        else
+            return _mm_sub_epi64(counters, mask);
+    }
+
+    template <typename TValue>
+    __m128i broadcast(const TValue& value)
+    {
+        alignas(16) TValue lanes[16 / sizeof(TValue)];
+        std::fill(std::begin(lanes), std::end(lanes), value);
+        return _mm_load_si128(reinterpret_cast<const __m128i*>(lanes));
+    }
+
+    // every arg is broadcast to a register; compare masks (-1 on match) are subtracted from lane counters,
+    // which are added to the result after every block of iterations - before a lane counter can overflow
+    template <typename TValue, typename... TArgs>
+    size_t count_matches_sse2(const TValue* items, size_t size, const TArgs&... args)
+    {
+        constexpr size_t width = sizeof(TValue);
+        constexpr size_t lane_count = 16 / width;
+        using Counter = LaneCounter<width>;
+        static_assert(fits_lane_counter_v<TValue, sizeof...(args)>, "too many args for lane counters");
+        constexpr size_t block_size = std::min<size_t>(std::numeric_limits<Counter>::max() / sizeof...(args), 1 << 16) * lane_count;
+
+        const __m128i needles[] = {broadcast(args)...};
+        size_t num{0};
+
+        size_t i = 0;
+        while (i + lane_count <= size)
+        {
+            const size_t block_end = i + std::min(block_size, (size - i) / lane_count * lane_count);
+            __m128i counters = _mm_setzero_si128();
+
+            for (; i < block_end; i += lane_count)
+            {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(items + i));
+
+                for (const __m128i& needle : needles)
+                    counters = subtract_lanes<width>(counters, equal_lanes<TValue>(block, needle));
+            }
+
+            alignas(16) Counter lanes[lane_count];
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes), counters);
+
+            for (Counter lane : lanes)
+                num += lane;
+        }
+
+        return num + count_matches_scalar(items + i, size - i, args...);
+    }
+#endif
+
+    template <typename TValue, typename... TArgs>
+    size_t count_matches(const TValue* items, size_t size, const TArgs&... args)
+    {
+#ifdef FOLD_EX_HAS_SSE2
+        if constexpr (has_sse2_lanes_v<TValue> && fits_lane_counter_v<TValue, sizeof...(args)>)
+            return count_matches_sse2(items, size, args...);
+        else
+#endif
+            return count_matches_scalar(items, size, args...);
+    }
+}
+
+// one pass over the container - every element is compared with all args
+template <typename TVec, typename... TArgs>
+int matches_single_pass(const TVec& v, const TArgs&... args)
+{
+    using TValue = std::decay_t<decltype(*std::begin(v))>;
+
+    if constexpr (Detail::is_contiguous_v<TVec> && std::is_arithmetic_v<TValue> && (... && std::is_same_v<TValue, TArgs>))
+    {
+        return static_cast<int>(Detail::count_matches(std::data(v), std::size(v), args...));
+    }
+    else
+    {
+        int num{0};
+        for (const auto& item : v)
+        {
+            num += (... + static_cast<int>(item == args));
+        }
+
+        return num;
+    }
 }
 
 TEST_CASE("matches - returns how many items is stored in a container")
@@ -40,6 +210,121 @@ TEST_CASE("matches - returns how many items is stored in a container")
     REQUIRE(matches("abccdef", 'a', 'c', 'f') == 4);
 }
 
+TEST_CASE("matches_single_pass - same results as fold of counts")
+{
+    vector<int> v{1, 2, 3, 4, 5, 2};
+
+    REQUIRE(matches_single_pass(v, 2, 5) == matches(v, 2, 5));
+    REQUIRE(matches_single_pass(v, 100, 200) == 0);
+    REQUIRE(matches_single_pass(v, 2, 2) == 4); // every arg is counted separately
+    REQUIRE(matches_single_pass("abccdef", 'x', 'y', 'z') == 0);
+    REQUIRE(matches_single_pass("abccdef", 'a', 'c', 'f') == 4);
+
+    set<string> words{"one", "two", "three"};
+    REQUIRE(matches_single_pass(words, "two"s, "four"s) == 1);
+}
+
+namespace
+{
+    // long enough to exceed the range of 8-bit lane counters, with a tail shorter than a register
+    template <typename TValue>
+    void check_matches_single_pass()
+    {
+        vector<TValue> v(5'003);
+        for (size_t i = 0; i < v.size(); ++i)
+            v[i] = static_cast<TValue>(i % 7);
+
+        REQUIRE(matches_single_pass(v, TValue(3), TValue(5)) == matches(v, TValue(3), TValue(5)));
+        REQUIRE(matches_single_pass(v, TValue(0), TValue(0), TValue(6)) == matches(v, TValue(0), TValue(0), TValue(6)));
+        REQUIRE(matches_single_pass(v, TValue(42)) == 0);
+    }
+
+    // one needle for every byte value
+    template <size_t... Is>
+    int matches_single_pass_all_bytes(const vector<uint8_t>& v, std::index_sequence<Is...>)
+    {
+        return matches_single_pass(v, static_cast<uint8_t>(Is)...);
+    }
+}
+
+TEST_CASE("matches_single_pass - arithmetic element types")
+{
+    check_matches_single_pass<char>();
+    check_matches_single_pass<uint8_t>();
+    check_matches_single_pass<short>();
+    check_matches_single_pass<int>();
+    check_matches_single_pass<unsigned int>();
+    check_matches_single_pass<int64_t>();
+    check_matches_single_pass<float>();
+    check_matches_single_pass<double>();
+
+    SECTION("floating point equality - NaN never matches, -0.0 == 0.0")
+    {
+        const vector<double> v = {0.0, -0.0, std::numeric_limits<double>::quiet_NaN(), 1.5};
+        REQUIRE(matches_single_pass(v, 0.0, std::numeric_limits<double>::quiet_NaN()) == 2);
+    }
+
+    SECTION("64-bit values differing in one half")
+    {
+        const vector<int64_t> v = {1, (int64_t{1} << 32) + 1, int64_t{1} << 32, -1};
+        REQUIRE(matches_single_pass(v, int64_t{1}, int64_t{-1}) == 2);
+    }
+
+    SECTION("more needles than an 8-bit lane counter can hold")
+    {
+        vector<uint8_t> v(1'000);
+        for (size_t i = 0; i < v.size(); ++i)
+            v[i] = static_cast<uint8_t>(i);
+
+        REQUIRE(matches_single_pass_all_bytes(v, std::make_index_sequence<256>{}) == 1'000);
+    }
+}
+
+namespace
+{
+    template <size_t... Is>
+    int matches_needles(const vector<int>& v, std::index_sequence<Is...>)
+    {
+        return matches(v, static_cast<int>(Is * 7)...);
+    }
+
+    template <size_t... Is>
+    int matches_single_pass_needles(const vector<int>& v, std::index_sequence<Is...>)
+    {
+        return matches_single_pass(v, static_cast<int>(Is * 7)...);
+    }
+
+    template <size_t N>
+    void benchmark_matches(const vector<int>& v)
+    {
+        REQUIRE(matches_needles(v, std::make_index_sequence<N>{}) == matches_single_pass_needles(v, std::make_index_sequence<N>{}));
+
+        BENCHMARK("fold of std::count - " + std::to_string(N) + " needles")
+        {
+            return matches_needles(v, std::make_index_sequence<N>{});
+        };
+
+        BENCHMARK("single pass - " + std::to_string(N) + " needles")
+        {
+            return matches_single_pass_needles(v, std::make_index_sequence<N>{});
+        };
+    }
+}
+
+TEST_CASE("matches - benchmark", "[.benchmark]")
+{
+    vector<int> v(10'000'000);
+    std::mt19937 rnd_gen{42};
+    std::uniform_int_distribution<int> distr{0, 1000};
+    std::generate(begin(v), end(v), [&] { return distr(rnd_gen); });
+
+    benchmark_matches<1>(v);
+    benchmark_matches<2>(v);
+    benchmark_matches<4>(v);
+    benchmark_matches<8>(v);
+    benchmark_matches<16>(v);
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 class Gadget
@@ -63,7 +348,17 @@ template <typename... TArgs>
 {
     std::vector<std::common_type_t<TArgs...>> vec;
     vec.reserve(sizeof...(args));
-    (..., vec.push_back(std::forward<TArgs>(args)));
+    (..., vec.emplace_back(std::forward<TArgs>(args)));
+
+    return vec;
+}
+
+template <size_t N, typename... TArgs>
+[[nodiscard]] auto make_small_vector(TArgs&&... args)
+{
+    SmallVector<std::common_type_t<TArgs...>, N> vec;
+    vec.reserve(sizeof...(args));
+    (..., vec.emplace_back(std::forward<TArgs>(args)));
 
     return vec;
 }
@@ -100,6 +395,172 @@ TEST_CASE("make_vector - create vector from a list of arguments")
     }
 }
 
+TEST_CASE("make_small_vector - inline storage for small number of arguments")
+{
+    SECTION("ints")
+    {
+        const size_t allocations_before = AllocationCounter::allocations;
+        auto v = make_small_vector<4>(1, 2, 3);
+        const size_t allocations_after = AllocationCounter::allocations;
+
+        REQUIRE(allocations_after == allocations_before);
+        REQUIRE(v.is_inline());
+        auto expected = {1, 2, 3};
+        REQUIRE(std::equal(v.begin(), v.end(), expected.begin(), expected.end()));
+    }
+
+    SECTION("make_vector allocates even for two ints")
+    {
+        const size_t allocations_before = AllocationCounter::allocations;
+        auto v = make_vector(1, 2);
+        const size_t allocations_after = AllocationCounter::allocations;
+
+        REQUIRE(allocations_after == allocations_before + 1);
+    }
+
+    SECTION("more arguments than inline capacity go to the heap")
+    {
+        const size_t allocations_before = AllocationCounter::allocations;
+        auto v = make_small_vector<2>(1, 2, 3, 4, 5);
+        const size_t allocations_after = AllocationCounter::allocations;
+
+        REQUIRE(allocations_after == allocations_before + 1);
+        REQUIRE_FALSE(v.is_inline());
+        REQUIRE(v.size() == 5);
+        REQUIRE(v[4] == 5);
+    }
+
+    SECTION("growth past inline capacity")
+    {
+        auto v = make_small_vector<2>("a"s, "b"s);
+        v.emplace_back(v[0]);
+        v.emplace_back(3, 'c');
+
+        auto expected = {"a"s, "b"s, "a"s, "ccc"s};
+        REQUIRE(std::equal(v.begin(), v.end(), expected.begin(), expected.end()));
+    }
+
+    SECTION("unique_ptrs with polymorphic hierarchy")
+    {
+        auto gadgets = make_small_vector<4>(make_unique<Gadget>(), make_unique<SuperGadget>());
+
+        static_assert(is_same_v<decltype(gadgets)::value_type, unique_ptr<Gadget>>);
+        REQUIRE(gadgets[1]->id() == "b");
+
+        auto moved_gadgets = std::move(gadgets);
+        REQUIRE(moved_gadgets.size() == 2);
+        REQUIRE(gadgets.empty());
+    }
+
+    SECTION("copy & move")
+    {
+        auto v1 = make_small_vector<2>(1, 2, 3);
+        auto v2 = v1;
+        REQUIRE(v1 == v2);
+
+        auto v3 = make_small_vector<2>(4);
+        v3 = std::move(v1);
+        REQUIRE(v3 == v2);
+
+        v1 = v3;
+        REQUIRE(v1 == v2);
+    }
+}
+
+namespace
+{
+    // copy constructor throws on the given copy
+    struct ThrowingCopy
+    {
+        inline static int copies_until_throw = -1;
+
+        ThrowingCopy() = default;
+
+        ThrowingCopy(const ThrowingCopy&)
+        {
+            if (copies_until_throw-- == 0)
+                throw std::runtime_error{"copy failed"};
+        }
+
+        ThrowingCopy& operator=(const ThrowingCopy&) = default;
+    };
+}
+
+TEST_CASE("SmallVector - copy constructor releases heap buffer when a copy throws")
+{
+    SmallVector<ThrowingCopy, 2> source;
+    for (int i = 0; i < 4; ++i)
+        source.emplace_back();
+    REQUIRE_FALSE(source.is_inline());
+
+    const size_t allocations_before = AllocationCounter::allocations;
+    const size_t deallocations_before = AllocationCounter::deallocations;
+
+    bool thrown = false;
+    ThrowingCopy::copies_until_throw = 2;
+    try
+    {
+        SmallVector<ThrowingCopy, 2> copy = source;
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    ThrowingCopy::copies_until_throw = -1;
+
+    REQUIRE(thrown);
+    REQUIRE(AllocationCounter::allocations - allocations_before == AllocationCounter::deallocations - deallocations_before);
+}
+
+TEST_CASE("make_small_vector - benchmark", "[.benchmark]")
+{
+    constexpr int iterations = 1'000'000;
+
+    BENCHMARK("make_vector - 2 ints")
+    {
+        int sum{};
+        for (int i = 0; i < iterations; ++i)
+        {
+            auto v = make_vector(i, i + 1);
+            sum += v[1];
+        }
+        return sum;
+    };
+
+    BENCHMARK("make_small_vector<4> - 2 ints")
+    {
+        int sum{};
+        for (int i = 0; i < iterations; ++i)
+        {
+            auto v = make_small_vector<4>(i, i + 1);
+            sum += v[1];
+        }
+        return sum;
+    };
+
+    BENCHMARK("make_vector - 4 strings")
+    {
+        size_t length{};
+        for (int i = 0; i < iterations / 10; ++i)
+        {
+            auto v = make_vector("one"s, "two"s, "three"s, "four"s);
+            length += v[3].size();
+        }
+        return length;
+    };
+
+    BENCHMARK("make_small_vector<4> - 4 strings")
+    {
+        size_t length{};
+        for (int i = 0; i < iterations / 10; ++i)
+        {
+            auto v = make_small_vector<4>("one"s, "two"s, "three"s, "four"s);
+            length += v[3].size();
+        }
+        return length;
+    };
+}
+
 // /////////////////////////////////////////////////////////////////////////////////////////////////
 
 template <typename T>
@@ -123,4 +584,227 @@ TEST_CASE("combined_hash - write a function that calculates combined hash value
     REQUIRE(combined_hash(1U) == 2654435770U);
     REQUIRE(combined_hash(1, 3.14, "string"s) == 10365827363824479057U);
     REQUIRE(combined_hash(123L, "abc"sv, 234, 3.14f) == 162170636579575197U);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Hash64::combined_hash - 64-bit mixer")
+{
+    SECTION("streaming state gives the same result as variadic call")
+    {
+        Hash64::HashState state;
+        state.update(123L).update("abc"sv).update(234).update(3.14f);
+
+        REQUIRE(state.digest() == Hash64::combined_hash(123L, "abc"sv, 234, 3.14f));
+    }
+
+    SECTION("equal values of string-like types hash the same")
+    {
+        REQUIRE(Hash64::combined_hash("abc"s, 1) == Hash64::combined_hash("abc"sv, 1));
+        REQUIRE(Hash64::combined_hash("abc", 1) == Hash64::combined_hash("abc"sv, 1));
+        REQUIRE(Hash64::combined_hash(0.0) == Hash64::combined_hash(-0.0));
+    }
+
+    SECTION("order of arguments matters")
+    {
+        REQUIRE(Hash64::combined_hash(1, 2) != Hash64::combined_hash(2, 1));
+        REQUIRE(Hash64::combined_hash("ab"sv, "c"sv) != Hash64::combined_hash("a"sv, "bc"sv));
+    }
+
+    SECTION("no collisions for a dense grid of integer pairs")
+    {
+        std::unordered_set<uint64_t> hashes;
+
+        for (int x = 0; x < 512; ++x)
+            for (int y = 0; y < 512; ++y)
+                hashes.insert(Hash64::combined_hash(x, y));
+
+        REQUIRE(hashes.size() == 512 * 512);
+    }
+
+    SECTION("low bits are evenly distributed for integer pairs")
+    {
+        constexpr size_t bucket_count = 1024;
+        std::vector<size_t> buckets(bucket_count);
+
+        for (int x = 0; x < 256; ++x)
+            for (int y = 0; y < 256; ++y)
+                ++buckets[Hash64::combined_hash(x, y) % bucket_count];
+
+        // expected load is 64 per bucket
+        REQUIRE(*std::max_element(begin(buckets), end(buckets)) < 110);
+        REQUIRE(*std::min_element(begin(buckets), end(buckets)) > 25);
+    }
+
+    SECTION("avalanche - flipping one input bit flips about half of the output bits")
+    {
+        std::mt19937_64 rnd_gen{665};
+        double total_flipped{};
+        size_t samples{};
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            const uint64_t value = rnd_gen();
+            const uint64_t h = Hash64::combined_hash(value);
+
+            for (int bit = 0; bit < 64; ++bit)
+            {
+                total_flipped += std::bitset<64>(h ^ Hash64::combined_hash(value ^ (uint64_t{1} << bit))).count();
+                ++samples;
+            }
+        }
+
+        REQUIRE_THAT(total_flipped / samples, Catch::Matchers::WithinAbs(32.0, 1.0));
+    }
+
+    SECTION("batch API")
+    {
+        const std::vector<std::tuple<int, std::string>> keys = {{1, "one"}, {2, "two"}, {3, "three"}};
+        std::vector<uint64_t> hashes(keys.size());
+
+        Hash64::combined_hash_batch(begin(keys), end(keys), begin(hashes));
+
+        for (size_t i = 0; i < keys.size(); ++i)
+            REQUIRE(hashes[i] == Hash64::TupleHash{}(keys[i]));
+    }
+}
+
+namespace CompileTimeHashing
+{
+    enum class Method
+    {
+        get,
+        post
+    };
+
+    static_assert(Hash64::combined_hash(1, 2) != Hash64::combined_hash(2, 1));
+    static_assert(Hash64::combined_hash("abc"sv) == Hash64::combined_hash("abc"));
+    static_assert(Hash64::combined_hash(Method::post) == Hash64::combined_hash(1));
+    static_assert(Hash64::combined_hash("/api/v1/users/profile"sv) != Hash64::combined_hash("/api/v1/users/profilE"sv));
+
+    int route(std::string_view path, Method method)
+    {
+        switch (Hash64::combined_hash(path, method))
+        {
+            case Hash64::combined_hash("/users"sv, Method::get):
+                return 1;
+            case Hash64::combined_hash("/users"sv, Method::post):
+                return 2;
+            case Hash64::combined_hash("/orders"sv, Method::get):
+                return 3;
+            default:
+                return 0;
+        }
+    }
+
+    constexpr Hash64::StaticHashMap<int, 4> http_status{{{
+        {Hash64::combined_hash("OK"sv), 200},
+        {Hash64::combined_hash("Created"sv), 201},
+        {Hash64::combined_hash("Not Found"sv), 404},
+        {Hash64::combined_hash("Internal Server Error"sv), 500},
+    }}};
+
+    static_assert(*http_status.find_key("Not Found"sv) == 404);
+    static_assert(http_status.find_key("Teapot"sv) == nullptr);
+
+    struct ThrowingKey
+    {
+    };
+}
+
+template <>
+struct std::hash<CompileTimeHashing::ThrowingKey>
+{
+    size_t operator()(const CompileTimeHashing::ThrowingKey&) const
+    {
+        throw std::runtime_error{"hash failed"};
+    }
+};
+
+namespace CompileTimeHashing
+{
+    static_assert(noexcept(Hash64::combined_hash(std::declval<const std::string&>(), 1, 2.0, Method::get)));
+    static_assert(!noexcept(Hash64::combined_hash(1, ThrowingKey{})));
+}
+
+TEST_CASE("Hash64::combined_hash - compile-time hashing")
+{
+    using namespace CompileTimeHashing;
+
+    SECTION("constexpr results match runtime results")
+    {
+        constexpr uint64_t ct_hash = Hash64::combined_hash("key"sv, 42, Method::get, 'x', 7ULL);
+
+        std::string key = "key";
+        volatile int value = 42; // forces runtime evaluation
+        REQUIRE(Hash64::combined_hash(key, static_cast<int>(value), Method::get, 'x', 7ULL) == ct_hash);
+
+        constexpr uint64_t ct_long_string = Hash64::combined_hash("a string longer than sixteen bytes"sv);
+        REQUIRE(Hash64::combined_hash("a string longer than sixteen bytes"s) == ct_long_string);
+    }
+
+    SECTION("switch on precomputed keys")
+    {
+        REQUIRE(route("/users", Method::get) == 1);
+        REQUIRE(route("/users"s, Method::post) == 2);
+        REQUIRE(route("/orders", Method::get) == 3);
+        REQUIRE(route("/orders", Method::post) == 0);
+    }
+
+    SECTION("static perfect-hash map")
+    {
+        std::string status = "Created";
+        REQUIRE(*http_status.find_key(status) == 201);
+        REQUIRE(http_status.find_key("Accepted"s) == nullptr);
+    }
+
+    SECTION("exception from std::hash is propagated")
+    {
+        REQUIRE_THROWS_AS(Hash64::combined_hash(1, ThrowingKey{}), std::runtime_error);
+    }
+
+    SECTION("duplicate key hashes are rejected")
+    {
+        const std::array<std::pair<uint64_t, int>, 2> items = {{{Hash64::combined_hash("OK"sv), 200}, {Hash64::combined_hash("OK"sv), 201}}};
+        REQUIRE_THROWS_AS((Hash64::StaticHashMap<int, 2>{items}), std::invalid_argument);
+    }
+}
+
+TEST_CASE("combined_hash - benchmark", "[.benchmark]")
+{
+    std::vector<std::tuple<int, int, long>> keys(1'000'000);
+    std::mt19937 rnd_gen{42};
+    std::generate(begin(keys), end(keys), [&] { return std::tuple{int(rnd_gen()), int(rnd_gen()), long(rnd_gen())}; });
+
+    std::vector<uint64_t> hashes(keys.size());
+
+    BENCHMARK("boost-style combined_hash")
+    {
+        for (size_t i = 0; i < keys.size(); ++i)
+            hashes[i] = std::apply([](const auto&... args) { return combined_hash(args...); }, keys[i]);
+        return hashes.back();
+    };
+
+    BENCHMARK("Hash64::combined_hash_batch")
+    {
+        Hash64::combined_hash_batch(begin(keys), end(keys), begin(hashes));
+        return hashes.back();
+    };
+
+    std::vector<std::string> words(100'000);
+    std::generate(begin(words), end(words), [&] { return std::string(5 + rnd_gen() % 30, char('a' + rnd_gen() % 26)); });
+
+    BENCHMARK("boost-style combined_hash - strings")
+    {
+        size_t h{};
+        for (const auto& w : words)
+            h += combined_hash(w, 42);
+        return h;
+    };
+
+    BENCHMARK("Hash64::combined_hash - strings")
+    {
+        uint64_t h{};
+        for (const auto& w : words)
+            h += Hash64::combined_hash(w, 42);
+        return h;
+    };
+}
@@ -0,0 +1,240 @@
+#ifndef SMALL_VECTOR_HPP
+#define SMALL_VECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// vector with inline storage for N items - heap is used only when size exceeds N
+template <typename T, size_t N>
+class SmallVector
+{
+    static_assert(N > 0, "inline capacity must be greater than zero");
+
+    alignas(T) unsigned char buffer_[N * sizeof(T)];
+    T* data_ = inline_data();
+    size_t size_{};
+    size_t capacity_ = N;
+
+    T* inline_data() noexcept
+    {
+        return reinterpret_cast<T*>(buffer_);
+    }
+
+    void release_heap() noexcept
+    {
+        if (!is_inline())
+        {
+            std::allocator<T>{}.deallocate(data_, capacity_);
+            data_ = inline_data();
+            capacity_ = N;
+        }
+    }
+
+    void steal(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (other.is_inline())
+        {
+            std::uninitialized_move(other.begin(), other.end(), data_);
+            size_ = other.size_;
+            other.clear();
+        }
+        else
+        {
+            data_ = std::exchange(other.data_, other.inline_data());
+            size_ = std::exchange(other.size_, 0);
+            capacity_ = std::exchange(other.capacity_, N);
+        }
+    }
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    SmallVector() noexcept = default;
+
+    SmallVector(const SmallVector& other)
+    {
+        reserve(other.size());
+
+        try
+        {
+            std::uninitialized_copy(other.begin(), other.end(), data_);
+        }
+        catch (...)
+        {
+            release_heap(); // destructor doesn't run for a partially constructed object
+            throw;
+        }
+
+        size_ = other.size_;
+    }
+
+    SmallVector& operator=(const SmallVector& other)
+    {
+        if (this != &other)
+        {
+            clear();
+            reserve(other.size());
+            std::uninitialized_copy(other.begin(), other.end(), data_);
+            size_ = other.size_;
+        }
+
+        return *this;
+    }
+
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        steal(std::move(other));
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this != &other)
+        {
+            clear();
+            release_heap();
+            steal(std::move(other));
+        }
+
+        return *this;
+    }
+
+    ~SmallVector()
+    {
+        clear();
+        release_heap();
+    }
+
+    bool is_inline() const noexcept
+    {
+        return data_ == reinterpret_cast<const T*>(buffer_);
+    }
+
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    void reserve(size_t new_capacity)
+    {
+        if (new_capacity <= capacity_)
+            return;
+
+        T* new_data = std::allocator<T>{}.allocate(new_capacity);
+
+        try
+        {
+            std::uninitialized_move(begin(), end(), new_data);
+        }
+        catch (...)
+        {
+            std::allocator<T>{}.deallocate(new_data, new_capacity);
+            throw;
+        }
+
+        std::destroy(begin(), end());
+        release_heap();
+
+        data_ = new_data;
+        capacity_ = new_capacity;
+    }
+
+    template <typename... TArgs>
+    T& emplace_back(TArgs&&... args)
+    {
+        if (size_ == capacity_)
+        {
+            T item(std::forward<TArgs>(args)...); // args may refer to items that are about to be relocated
+            reserve(2 * capacity_);
+            return emplace_back(std::move(item));
+        }
+
+        T* item = ::new (static_cast<void*>(data_ + size_)) T(std::forward<TArgs>(args)...);
+        ++size_;
+
+        return *item;
+    }
+
+    void push_back(const T& item)
+    {
+        emplace_back(item);
+    }
+
+    void push_back(T&& item)
+    {
+        emplace_back(std::move(item));
+    }
+
+    void clear() noexcept
+    {
+        std::destroy(begin(), end());
+        size_ = 0;
+    }
+
+    T* data() noexcept
+    {
+        return data_;
+    }
+
+    const T* data() const noexcept
+    {
+        return data_;
+    }
+
+    T& operator[](size_t index) noexcept
+    {
+        return data_[index];
+    }
+
+    const T& operator[](size_t index) const noexcept
+    {
+        return data_[index];
+    }
+
+    iterator begin() noexcept
+    {
+        return data_;
+    }
+
+    iterator end() noexcept
+    {
+        return data_ + size_;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return data_;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return data_ + size_;
+    }
+
+    friend bool operator==(const SmallVector& lhs, const SmallVector& rhs)
+    {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    friend bool operator!=(const SmallVector& lhs, const SmallVector& rhs)
+    {
+        return !(lhs == rhs);
+    }
+};
+
+#endif
@@ -0,0 +1,298 @@
+#ifndef COMPACT_OPTIONAL_HPP
+#define COMPACT_OPTIONAL_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// empty state encoded as one reserved value of T
+template <typename T, T Sentinel>
+struct sentinel_policy
+{
+    static constexpr T empty_value() noexcept
+    {
+        return Sentinel;
+    }
+
+    static constexpr bool is_empty(T value) noexcept
+    {
+        return value == Sentinel;
+    }
+};
+
+// empty state encoded as quiet NaN - every non-NaN value stays representable
+template <typename T>
+struct nan_policy
+{
+    static_assert(std::numeric_limits<T>::has_quiet_NaN);
+
+    static constexpr T empty_value() noexcept
+    {
+        return std::numeric_limits<T>::quiet_NaN();
+    }
+
+    static constexpr bool is_empty(T value) noexcept
+    {
+        return value != value;
+    }
+};
+
+template <typename T, typename = void>
+struct default_compact_policy
+{
+    using type = sentinel_policy<T, std::numeric_limits<T>::min()>;
+};
+
+template <typename T>
+struct default_compact_policy<T, std::enable_if_t<std::is_floating_point_v<T>>>
+{
+    using type = nan_policy<T>;
+};
+
+template <typename T>
+using default_compact_policy_t = typename default_compact_policy<T>::type;
+
+///////////////////////////////////////////////////////////////////////////
+// optional with the same size as T - the sentinel value can't be stored
+
+template <typename T, typename TPolicy = default_compact_policy_t<T>>
+class compact_optional
+{
+    static_assert(std::is_arithmetic_v<T>, "compact_optional supports arithmetic types only");
+
+    T value_ = TPolicy::empty_value();
+
+public:
+    using value_type = T;
+
+    constexpr compact_optional() noexcept = default;
+
+    constexpr compact_optional(std::nullopt_t) noexcept
+    {
+    }
+
+    constexpr compact_optional(T value) noexcept
+        : value_{value}
+    {
+        assert(is_representable(value) && "sentinel value can't be stored in compact_optional");
+    }
+
+    // throws std::invalid_argument when opt holds the sentinel - it would silently become empty
+    constexpr compact_optional(const std::optional<T>& opt)
+    {
+        if (opt)
+        {
+            if (!is_representable(*opt))
+                throw std::invalid_argument{"sentinel value can't be stored in compact_optional"};
+
+            value_ = *opt;
+        }
+    }
+
+    static constexpr bool is_representable(T value) noexcept
+    {
+        return !TPolicy::is_empty(value);
+    }
+
+    constexpr bool has_value() const noexcept
+    {
+        return !TPolicy::is_empty(value_);
+    }
+
+    constexpr explicit operator bool() const noexcept
+    {
+        return has_value();
+    }
+
+    constexpr const T& operator*() const noexcept
+    {
+        return value_;
+    }
+
+    constexpr const T& value() const
+    {
+        if (!has_value())
+            throw std::bad_optional_access{};
+
+        return value_;
+    }
+
+    constexpr T value_or(T default_value) const noexcept
+    {
+        return has_value() ? value_ : default_value;
+    }
+
+    constexpr void reset() noexcept
+    {
+        value_ = TPolicy::empty_value();
+    }
+
+    std::optional<T> to_optional() const
+    {
+        return has_value() ? std::optional<T>{value_} : std::nullopt;
+    }
+
+    friend constexpr bool operator==(const compact_optional& opt, std::nullopt_t) noexcept
+    {
+        return !opt.has_value();
+    }
+
+    friend constexpr bool operator!=(const compact_optional& opt, std::nullopt_t) noexcept
+    {
+        return opt.has_value();
+    }
+
+    friend constexpr bool operator==(const compact_optional& lhs, const compact_optional& rhs) noexcept
+    {
+        return lhs.has_value() == rhs.has_value() && (!lhs.has_value() || lhs.value_ == rhs.value_);
+    }
+
+    friend constexpr bool operator!=(const compact_optional& lhs, const compact_optional& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////
+// array of optionals - values stored densely, validity kept in a bitmap
+
+template <typename T>
+class optional_array
+{
+    using Word = std::uint64_t;
+    static constexpr size_t bits_per_word = std::numeric_limits<Word>::digits;
+
+    std::vector<T> values_;
+    std::vector<Word> validity_;
+
+    void set_valid(size_t index, bool is_valid)
+    {
+        const Word mask = Word{1} << (index % bits_per_word);
+
+        if (is_valid)
+            validity_[index / bits_per_word] |= mask;
+        else
+            validity_[index / bits_per_word] &= ~mask;
+    }
+
+public:
+    using value_type = std::optional<T>;
+
+    optional_array() = default;
+
+    explicit optional_array(size_t size)
+        : values_(size)
+        , validity_((size + bits_per_word - 1) / bits_per_word)
+    {
+    }
+
+    void reserve(size_t capacity)
+    {
+        values_.reserve(capacity);
+        validity_.reserve((capacity + bits_per_word - 1) / bits_per_word);
+    }
+
+    void push_back(const std::optional<T>& item)
+    {
+        if (values_.size() % bits_per_word == 0)
+            validity_.push_back(0);
+
+        values_.push_back(item.value_or(T{}));
+        set_valid(values_.size() - 1, item.has_value());
+    }
+
+    template <typename TPolicy>
+    void push_back(const compact_optional<T, TPolicy>& item)
+    {
+        push_back(item.to_optional());
+    }
+
+    void set(size_t index, const std::optional<T>& item)
+    {
+        values_[index] = item.value_or(T{});
+        set_valid(index, item.has_value());
+    }
+
+    size_t size() const noexcept
+    {
+        return values_.size();
+    }
+
+    bool empty() const noexcept
+    {
+        return values_.empty();
+    }
+
+    bool has_value(size_t index) const noexcept
+    {
+        return (validity_[index / bits_per_word] >> (index % bits_per_word)) & 1;
+    }
+
+    std::optional<T> operator[](size_t index) const
+    {
+        return has_value(index) ? std::optional<T>{values_[index]} : std::nullopt;
+    }
+
+    T value_or(size_t index, T default_value) const
+    {
+        return has_value(index) ? values_[index] : default_value;
+    }
+
+    // raw storage - slots without a value hold T{}
+    const T* data() const noexcept
+    {
+        return values_.data();
+    }
+
+    const Word* validity_bitmap() const noexcept
+    {
+        return validity_.data();
+    }
+
+    size_t count() const noexcept
+    {
+        size_t result{};
+
+        for (Word w : validity_)
+        {
+            for (; w != 0; w &= w - 1)
+                ++result;
+        }
+
+        return result;
+    }
+
+    size_t memory_footprint() const noexcept
+    {
+        return values_.size() * sizeof(T) + validity_.size() * sizeof(Word);
+    }
+
+    // calls f(index, value) for every slot that holds a value
+    template <typename F>
+    void for_each_value(F f) const
+    {
+        for (size_t w = 0; w < validity_.size(); ++w)
+        {
+            const Word bits = validity_[w];
+
+            if (bits == 0)
+                continue;
+
+            const size_t first = w * bits_per_word;
+            const size_t last = std::min(first + bits_per_word, values_.size());
+
+            for (size_t index = first; index < last; ++index)
+            {
+                if ((bits >> (index - first)) & 1)
+                    f(index, values_[index]);
+            }
+        }
+    }
+};
+
+#endif
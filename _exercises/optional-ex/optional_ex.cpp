@@ -1,10 +1,19 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "compact_optional.hpp"
+
+#include <catch2/benchmark/catch_benchmark_all.hpp>
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <charconv>
+#include <iostream>
+#include <numeric>
 #include <optional>
+#include <string>
 #include <string_view>
+#include <vector>
 
-[[nodiscard]] std::optional<int> to_int(std::string_view str)
+template <typename TOptional>
+[[nodiscard]] TOptional to_int_as(std::string_view str)
 {
     int value;
 
@@ -16,9 +25,25 @@
         return std::nullopt;
     }
 
+    if constexpr (!std::is_same_v<TOptional, std::optional<int>>)
+    {
+        if (!TOptional::is_representable(value))
+            return std::nullopt; // value reserved as the empty-state sentinel
+    }
+
     return value;
 }
 
+[[nodiscard]] std::optional<int> to_int(std::string_view str)
+{
+    return to_int_as<std::optional<int>>(str);
+}
+
+[[nodiscard]] compact_optional<int> to_compact_int(std::string_view str)
+{
+    return to_int_as<compact_optional<int>>(str);
+}
+
 TEST_CASE("to_int returning optional")
 {
     SECTION("happy path")
@@ -60,4 +85,158 @@ TEST_CASE("to_int returning optional")
             REQUIRE_FALSE(result.has_value());
         }
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("compact_optional")
+{
+    static_assert(sizeof(compact_optional<int>) == sizeof(int));
+    static_assert(sizeof(compact_optional<double>) == sizeof(double));
+
+    SECTION("default constructed is empty")
+    {
+        compact_optional<int> opt;
+
+        REQUIRE_FALSE(opt.has_value());
+        REQUIRE(opt == std::nullopt);
+        REQUIRE(opt.value_or(-1) == -1);
+        REQUIRE_THROWS_AS(opt.value(), std::bad_optional_access);
+    }
+
+    SECTION("holds a value")
+    {
+        compact_optional<int> opt = 42;
+
+        REQUIRE(opt.has_value());
+        REQUIRE(*opt == 42);
+        REQUIRE(opt.to_optional() == std::optional{42});
+
+        opt.reset();
+        REQUIRE(opt == std::nullopt);
+    }
+
+    SECTION("custom sentinel")
+    {
+        using OptIndex = compact_optional<int, sentinel_policy<int, -1>>;
+
+        OptIndex opt = 0;
+        REQUIRE(opt.has_value());
+        REQUIRE_FALSE(OptIndex::is_representable(-1));
+        REQUIRE_FALSE(OptIndex{}.has_value());
+    }
+
+    SECTION("NaN-boxed floating point")
+    {
+        compact_optional<double> opt;
+        REQUIRE_FALSE(opt.has_value());
+
+        opt = std::numeric_limits<double>::infinity();
+        REQUIRE(opt.has_value());
+    }
+
+    SECTION("returned from to_int")
+    {
+        REQUIRE(to_compact_int("123") == compact_optional<int>{123});
+        REQUIRE(to_compact_int("123a4") == std::nullopt);
+        REQUIRE(to_compact_int(std::to_string(std::numeric_limits<int>::min())) == std::nullopt);
+        REQUIRE(to_int(std::to_string(std::numeric_limits<int>::min())).has_value());
+    }
+
+    SECTION("from std::optional")
+    {
+        REQUIRE(compact_optional<int>{std::optional{7}} == compact_optional<int>{7});
+        REQUIRE(compact_optional<int>{std::optional<int>{}} == std::nullopt);
+
+        const std::optional<int> sentinel = std::numeric_limits<int>::min();
+        REQUIRE_THROWS_AS(compact_optional<int>{sentinel}, std::invalid_argument);
+
+        const std::optional<double> nan = std::numeric_limits<double>::quiet_NaN();
+        REQUIRE_THROWS_AS(compact_optional<double>{nan}, std::invalid_argument);
+    }
+}
+
+TEST_CASE("optional_array")
+{
+    optional_array<int> arr;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        if (i % 3 == 0)
+            arr.push_back(std::nullopt);
+        else
+            arr.push_back(i);
+    }
+
+    REQUIRE(arr.size() == 100);
+    REQUIRE(arr.count() == 66);
+    REQUIRE(arr[0] == std::nullopt);
+    REQUIRE(arr[1] == std::optional{1});
+    REQUIRE(arr[99] == std::nullopt);
+    REQUIRE(arr.value_or(99, -1) == -1);
+
+    arr.set(99, 7);
+    REQUIRE(arr[99] == std::optional{7});
+
+    arr.push_back(to_compact_int("665"));
+    REQUIRE(arr[100] == std::optional{665});
+
+    long sum{};
+    arr.for_each_value([&sum](size_t, int value) { sum += value; });
+    REQUIRE(sum == std::accumulate(arr.data(), arr.data() + arr.size(), 0L));
+}
+
+TEST_CASE("compact optionals - memory & scan throughput", "[.benchmark]")
+{
+    constexpr size_t size = 10'000'000;
+
+    std::vector<std::optional<int>> vec_std_optional;
+    std::vector<compact_optional<int>> vec_compact_optional;
+    optional_array<int> opt_array;
+
+    vec_std_optional.reserve(size);
+    vec_compact_optional.reserve(size);
+    opt_array.reserve(size);
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        std::optional<int> item = (i % 7 == 0) ? std::nullopt : std::optional{static_cast<int>(i % 1000)};
+        vec_std_optional.push_back(item);
+        vec_compact_optional.push_back(item);
+        opt_array.push_back(item);
+    }
+
+    std::cout << "bytes per element - vector<optional<int>>: " << sizeof(std::optional<int>)
+              << ", vector<compact_optional<int>>: " << sizeof(compact_optional<int>)
+              << ", optional_array<int>: " << static_cast<double>(opt_array.memory_footprint()) / size << "\n";
+
+    BENCHMARK("vector<optional<int>> - sum")
+    {
+        long sum{};
+        for (const auto& item : vec_std_optional)
+            sum += item.value_or(0);
+        return sum;
+    };
+
+    BENCHMARK("vector<compact_optional<int>> - sum")
+    {
+        long sum{};
+        for (const auto& item : vec_compact_optional)
+            sum += item.value_or(0);
+        return sum;
+    };
+
+    BENCHMARK("optional_array<int> - sum")
+    {
+        // empty slots hold 0 - no need to inspect the bitmap
+        return std::accumulate(opt_array.data(), opt_array.data() + opt_array.size(), 0L);
+    };
+
+    BENCHMARK("vector<optional<int>> - count")
+    {
+        return std::count_if(vec_std_optional.begin(), vec_std_optional.end(), [](const auto& item) { return item.has_value(); });
+    };
+
+    BENCHMARK("optional_array<int> - count")
+    {
+        return opt_array.count();
+    };
+}
@@ -0,0 +1,14 @@
+// one loop per translation unit - the object file size is the code size of the fast_visit dispatch
+#include "../fast_visit.hpp"
+#include "../shapes.hpp"
+
+#include <variant>
+#include <vector>
+
+double total_area_fast_visit(const std::vector<std::variant<Circle, Rectangle, Square>>& shapes)
+{
+    double total_area{};
+    for (const auto& shp : shapes)
+        total_area += fast_visit(calculate_area, shp);
+    return total_area;
+}
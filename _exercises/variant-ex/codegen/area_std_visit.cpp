@@ -0,0 +1,13 @@
+// one loop per translation unit - the object file size is the code size of the std::visit dispatch
+#include "../shapes.hpp"
+
+#include <variant>
+#include <vector>
+
+double total_area_std_visit(const std::vector<std::variant<Circle, Rectangle, Square>>& shapes)
+{
+    double total_area{};
+    for (const auto& shp : shapes)
+        total_area += std::visit(calculate_area, shp);
+    return total_area;
+}
@@ -0,0 +1,95 @@
+#ifndef FAST_VISIT_HPP
+#define FAST_VISIT_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace Detail
+{
+    template <typename V>
+    using remove_cvref_t = std::remove_cv_t<std::remove_reference_t<V>>;
+
+    template <typename F, typename V, size_t I>
+    using alternative_result_t = std::invoke_result_t<F, decltype(std::get<I>(std::declval<V>()))>;
+
+    template <typename F, typename V, size_t... Is>
+    constexpr bool same_results_v(std::index_sequence<Is...>)
+    {
+        return (... && std::is_same_v<alternative_result_t<F, V, 0>, alternative_result_t<F, V, Is>>);
+    }
+
+    template <size_t I, typename R, typename F, typename V>
+    constexpr R invoke_alternative(F&& f, V&& v)
+    {
+        return std::forward<F>(f)(std::get<I>(std::forward<V>(v)));
+    }
+
+    // address of the referenced object - also for rvalue references returned by a visitor
+    template <typename T>
+    constexpr std::remove_reference_t<T>* address_of(T&& ref) noexcept
+    {
+        return &ref;
+    }
+
+    // fold over index() == I generated from the index_sequence - a flat sequence of comparisons
+    // (lowered by the compiler to a switch) where every call can be inlined
+    template <typename R, typename F, typename V, size_t... Is>
+    constexpr R visit_alternative(F&& f, V&& v, std::index_sequence<Is...>)
+    {
+        const size_t index = v.index();
+
+        if constexpr (std::is_void_v<R>)
+        {
+            (void)(... || (index == Is && (invoke_alternative<Is, R>(std::forward<F>(f), std::forward<V>(v)), true)));
+        }
+        else if constexpr (std::is_reference_v<R>)
+        {
+            std::remove_reference_t<R>* result{};
+            (void)(... || (index == Is && (result = address_of(invoke_alternative<Is, R>(std::forward<F>(f), std::forward<V>(v))), true)));
+            return static_cast<R>(*result);
+        }
+        else if constexpr (std::is_default_constructible_v<R> && std::is_move_assignable_v<R>)
+        {
+            R result{};
+            (void)(... || (index == Is && (result = invoke_alternative<Is, R>(std::forward<F>(f), std::forward<V>(v)), true)));
+            return result;
+        }
+        else
+        {
+            // no way to hold the result - one indexed call through a table of function pointers
+            constexpr R (*dispatch_table[])(F&&, V&&) = {&invoke_alternative<Is, R, F, V>...};
+
+            return dispatch_table[index](std::forward<F>(f), std::forward<V>(v));
+        }
+    }
+}
+
+// std::visit replacement for a single variant; more variants are forwarded to std::visit
+template <typename F, typename... Vs>
+constexpr decltype(auto) fast_visit(F&& f, Vs&&... vs)
+{
+    if constexpr (sizeof...(Vs) == 1)
+    {
+        return [&f](auto&& v) -> decltype(auto) {
+            using V = decltype(v);
+            using R = Detail::alternative_result_t<F, V, 0>;
+
+            static_assert(Detail::same_results_v<F, V>(std::make_index_sequence<std::variant_size_v<Detail::remove_cvref_t<V>>>{}),
+                "visitor must return the same type for all alternatives");
+
+            if (v.valueless_by_exception())
+                throw std::bad_variant_access{};
+
+            return Detail::visit_alternative<R>(std::forward<F>(f), std::forward<V>(v),
+                std::make_index_sequence<std::variant_size_v<Detail::remove_cvref_t<V>>>{});
+        }(std::forward<Vs>(vs)...);
+    }
+    else
+    {
+        return std::visit(std::forward<F>(f), std::forward<Vs>(vs)...);
+    }
+}
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef PARALLEL_AREA_HPP
+#define PARALLEL_AREA_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <future>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+namespace Detail
+{
+    inline double pairwise_sum(const double* values, size_t size)
+    {
+        if (size <= 8)
+        {
+            double sum{};
+            for (size_t i = 0; i < size; ++i)
+                sum += values[i];
+            return sum;
+        }
+
+        const size_t half = size / 2;
+        return pairwise_sum(values, half) + pairwise_sum(values + half, size - half);
+    }
+
+    // Neumaier variant of Kahan summation
+    template <typename TIterator, typename TTransform>
+    double compensated_sum(TIterator first, TIterator last, TTransform& transform)
+    {
+        double sum{};
+        double compensation{};
+
+        for (; first != last; ++first)
+        {
+            const double value = transform(*first);
+            const double t = sum + value;
+
+            if (std::abs(sum) >= std::abs(value))
+                compensation += (sum - t) + value;
+            else
+                compensation += (value - t) + sum;
+
+            sum = t;
+        }
+
+        return sum + compensation;
+    }
+}
+
+// Range is split into fixed-size chunks that don't depend on the number of threads. Every chunk
+// is summed with compensation and chunk sums are combined pairwise - the result is bit-for-bit
+// the same for any num_threads.
+template <typename TIterator, typename TTransform>
+double deterministic_transform_reduce(TIterator first, TIterator last, TTransform transform,
+    unsigned int num_threads = std::max(1U, std::thread::hardware_concurrency()))
+{
+    constexpr size_t chunk_size = 4096;
+
+    const size_t size = static_cast<size_t>(std::distance(first, last));
+    const size_t chunk_count = (size + chunk_size - 1) / chunk_size;
+
+    std::vector<double> chunk_sums(chunk_count);
+
+    auto sum_chunks = [&, transform](size_t first_chunk, size_t last_chunk) mutable {
+        for (size_t chunk = first_chunk; chunk < last_chunk; ++chunk)
+        {
+            const auto chunk_first = std::next(first, chunk * chunk_size);
+            const auto chunk_last = std::next(chunk_first, std::min(chunk_size, size - chunk * chunk_size));
+            chunk_sums[chunk] = Detail::compensated_sum(chunk_first, chunk_last, transform);
+        }
+    };
+
+    const size_t task_count = std::clamp<size_t>(num_threads, 1, std::max<size_t>(chunk_count, 1));
+    const size_t chunks_per_task = (chunk_count + task_count - 1) / task_count;
+
+    std::vector<std::future<void>> tasks;
+    for (size_t task = 1; task < task_count; ++task)
+    {
+        const size_t first_chunk = std::min(task * chunks_per_task, chunk_count);
+        const size_t last_chunk = std::min(first_chunk + chunks_per_task, chunk_count);
+        tasks.push_back(std::async(std::launch::async, sum_chunks, first_chunk, last_chunk));
+    }
+
+    sum_chunks(0, std::min(chunks_per_task, chunk_count));
+
+    for (auto& task : tasks)
+        task.get();
+
+    return Detail::pairwise_sum(chunk_sums.data(), chunk_count);
+}
+
+#endif
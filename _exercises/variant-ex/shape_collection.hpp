@@ -0,0 +1,103 @@
+#ifndef SHAPE_COLLECTION_HPP
+#define SHAPE_COLLECTION_HPP
+
+#include "shapes.hpp"
+
+#include <cstdint>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+// area kernels over homogeneous arrays - integer accumulation is exact and vectorizes
+// without reassociating floating point sums
+inline double total_area(const std::vector<Circle>& circles)
+{
+    int64_t sum_r2{};
+    for (const auto& c : circles)
+        sum_r2 += int64_t{c.radius} * c.radius;
+
+    return static_cast<double>(sum_r2) * pi<double>;
+}
+
+inline double total_area(const std::vector<Rectangle>& rectangles)
+{
+    int64_t sum{};
+    for (const auto& r : rectangles)
+        sum += int64_t{r.width} * r.height;
+
+    return static_cast<double>(sum);
+}
+
+inline double total_area(const std::vector<Square>& squares)
+{
+    int64_t sum{};
+    for (const auto& s : squares)
+        sum += int64_t{s.size} * s.size;
+
+    return static_cast<double>(sum);
+}
+
+// structure-of-arrays storage - one contiguous array per alternative,
+// items are visited grouped by type (insertion order is not kept)
+template <typename... TShapes>
+class ShapeCollection
+{
+    std::tuple<std::vector<TShapes>...> shapes_;
+
+public:
+    using value_type = std::variant<TShapes...>;
+
+    template <typename TShape>
+    void push_back(const TShape& shape)
+    {
+        std::get<std::vector<TShape>>(shapes_).push_back(shape);
+    }
+
+    void push_back(const value_type& shape)
+    {
+        std::visit([this](const auto& s) { push_back(s); }, shape);
+    }
+
+    template <typename TShape>
+    void reserve(size_t capacity)
+    {
+        std::get<std::vector<TShape>>(shapes_).reserve(capacity);
+    }
+
+    template <typename TShape>
+    const std::vector<TShape>& all() const noexcept
+    {
+        return std::get<std::vector<TShape>>(shapes_);
+    }
+
+    size_t size() const noexcept
+    {
+        return (... + all<TShapes>().size());
+    }
+
+    void clear() noexcept
+    {
+        (..., std::get<std::vector<TShapes>>(shapes_).clear());
+    }
+
+    // variant-style view - f is called with every shape as its concrete type
+    template <typename F>
+    void visit_all(F&& f) const
+    {
+        auto visit_type = [&f](const auto& shapes) {
+            for (const auto& shape : shapes)
+                f(shape);
+        };
+
+        std::apply([&visit_type](const auto&... shapes) { (..., visit_type(shapes)); }, shapes_);
+    }
+
+    double total_area() const
+    {
+        return std::apply([](const auto&... shapes) { return (... + ::total_area(shapes)); }, shapes_);
+    }
+};
+
+using Shapes = ShapeCollection<Circle, Rectangle, Square>;
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef SHAPE_RENDERER_HPP
+#define SHAPE_RENDERER_HPP
+
+#include "shape_collection.hpp"
+#include "shapes.hpp"
+
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+// text of Shape::draw() formatted with std::to_chars - no locale, no stream state
+namespace Rendering
+{
+    constexpr size_t max_int_length = std::numeric_limits<int>::digits10 + 2; // digits + sign
+
+    inline char* append(char* out, std::string_view text) noexcept
+    {
+        std::memcpy(out, text.data(), text.size());
+        return out + text.size();
+    }
+
+    inline char* append(char* out, int value) noexcept
+    {
+        return std::to_chars(out, out + max_int_length, value).ptr;
+    }
+
+    inline char* format_draw(char* out, const Circle& c) noexcept
+    {
+        out = append(out, "Drawing Circle with r: ");
+        out = append(out, c.radius);
+        return append(out, "\n");
+    }
+
+    inline char* format_draw(char* out, const Rectangle& r) noexcept
+    {
+        out = append(out, "Drawing Rectangle with w: ");
+        out = append(out, r.width);
+        out = append(out, " & h: ");
+        out = append(out, r.height);
+        return append(out, "\n");
+    }
+
+    inline char* format_draw(char* out, const Square& s) noexcept
+    {
+        out = append(out, "Drawing Square with size: ");
+        out = append(out, s.size);
+        return append(out, "\n");
+    }
+
+    // upper bound of the formatted line length for all shapes
+    constexpr size_t max_line_length = 40 + 2 * max_int_length;
+}
+
+// formats shapes into one preallocated buffer that is emitted with a single write
+class DrawBuffer
+{
+    std::vector<char> buffer_;
+    size_t size_{};
+
+    char* reserve_for(size_t length)
+    {
+        if (buffer_.size() < size_ + length)
+            buffer_.resize(std::max(2 * buffer_.size(), size_ + length));
+
+        return buffer_.data() + size_;
+    }
+
+public:
+    explicit DrawBuffer(size_t capacity = 4096)
+        : buffer_(capacity)
+    {
+    }
+
+    template <typename TShape>
+    void draw(const TShape& shape)
+    {
+        char* out = reserve_for(Rendering::max_line_length);
+        size_ = Rendering::format_draw(out, shape) - buffer_.data();
+    }
+
+    template <typename TShape>
+    void draw_all(const std::vector<TShape>& shapes)
+    {
+        char* out = reserve_for(shapes.size() * Rendering::max_line_length);
+
+        for (const auto& shape : shapes)
+            out = Rendering::format_draw(out, shape);
+
+        size_ = out - buffer_.data();
+    }
+
+    // type-grouped - one homogeneous formatting loop per alternative
+    template <typename... TShapes>
+    void draw_all(const ShapeCollection<TShapes...>& shapes)
+    {
+        reserve_for(shapes.size() * Rendering::max_line_length);
+        (..., draw_all(shapes.template all<TShapes>()));
+    }
+
+    std::string_view view() const noexcept
+    {
+        return {buffer_.data(), size_};
+    }
+
+    void flush(std::ostream& out)
+    {
+        out.write(buffer_.data(), static_cast<std::streamsize>(size_));
+        size_ = 0;
+    }
+};
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef SHAPES_HPP
+#define SHAPES_HPP
+
+#include <iostream>
+
+// variable template
+template <typename T>
+constexpr T pi = 3.141592653589793238;
+
+struct Circle
+{
+    int radius;
+
+    void draw() const
+    {
+        std::cout << "Drawing Circle with r: " << radius << "\n";
+    }
+};
+
+struct Rectangle
+{
+    int width, height;
+
+    void draw() const
+    {
+        std::cout << "Drawing Rectangle with w: " << width << " & h: " << height << "\n";
+    }
+};
+
+struct Square
+{
+    int size;
+
+    void draw() const
+    {
+        std::cout << "Drawing Square with size: " << size << "\n";
+    }
+};
+
+template <typename... Ts>
+struct overload : Ts...
+{
+    using Ts::operator()...;
+};
+
+// deduction guide
+template <typename... Ts>
+overload(Ts...) -> overload<Ts...>;
+
+inline constexpr auto calculate_area = overload{
+    [](const Circle& c) -> double
+    { return c.radius * c.radius * pi<double>; },
+    [](const Rectangle& r) -> double
+    { return static_cast<double>(r.width) * r.height; },
+    [](const Square& s) -> double
+    { return static_cast<double>(s.size) * s.size; }};
+
+#endif
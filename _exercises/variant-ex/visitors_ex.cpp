@@ -1,16 +1,22 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "fast_visit.hpp"
+#include "parallel_area.hpp"
+#include "shape_collection.hpp"
+#include "shape_renderer.hpp"
+#include "shapes.hpp"
+
+#include <catch2/benchmark/catch_benchmark_all.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 #include <iostream>
+#include <random>
+#include <sstream>
 #include <string>
 #include <variant>
 #include <vector>
 
 using namespace std;
 
-// variable template
-template <typename T>
-constexpr T pi = 3.141592653589793238;
-
 namespace Explain
 {
     // variable template
@@ -21,46 +27,6 @@ namespace Explain
 
 static_assert(std::is_integral<int>::value);
 
-struct Circle
-{
-    int radius;
-
-    void draw() const
-    {
-        std::cout << "Drawing Circle with r: " << radius << "\n";
-    }
-};
-
-struct Rectangle
-{
-    int width, height;
-
-    void draw() const
-    {
-        std::cout << "Drawing Rectangle with w: " << width << " & h: " << height << "\n";
-    }
-};
-
-struct Square
-{
-    int size;
-
-    void draw() const
-    {
-        std::cout << "Drawing Square with size: " << size << "\n";
-    }
-};
-
-template <typename... Ts>
-struct overload : Ts...
-{
-    using Ts::operator()...;
-};
-
-// deduction guide
-template <typename... Ts>
-overload(Ts...) -> overload<Ts...>;
-
 TEST_CASE("visit a shape variant and calculate area")
 {
     using Shape = variant<Circle, Rectangle, Square>;
@@ -118,31 +84,153 @@ TEST_CASE("visit a shape variant and calculate area")
 }
 
 
-class Shape
+template <typename... TShapes>
+class BasicShape
 {
-    using TShape = variant<Circle, Rectangle, Square>;
+    using TShape = variant<TShapes...>;
 
     TShape shape_;
-public:
+
     template <typename T>
-    Shape(T&& shape) : shape_{std::forward<T>(shape)}
+    using EnableIfAlternative = std::enable_if_t<!std::is_same_v<std::decay_t<T>, BasicShape>>;
+
+    // aggregates (Circle, Rectangle, Square) can't be constructed with parentheses before C++20
+    template <typename T, typename... TArgs>
+    static TShape make_in_place(TArgs&&... args)
     {
+        if constexpr (std::is_constructible_v<T, TArgs...>)
+            return TShape{std::in_place_type<T>, std::forward<TArgs>(args)...};
+        else
+            return TShape{std::in_place_type<T>, T{std::forward<TArgs>(args)...}};
     }
 
-    template <typename T>
-    Shape& operator=(const T& shape) 
+public:
+    template <typename T, typename = EnableIfAlternative<T>>
+    BasicShape(T&& shape) : shape_{std::forward<T>(shape)}
+    {
+    }
+
+    template <typename T, typename... TArgs>
+    explicit BasicShape(std::in_place_type_t<T>, TArgs&&... args)
+        : shape_{make_in_place<T>(std::forward<TArgs>(args)...)}
     {
-        shape_ = shape;
+    }
+
+    // exactly one copy (lvalue) or move (rvalue) of the new alternative - unlike
+    // variant::operator=, no temporary is made for types with throwing copy constructors
+    template <typename T, typename = EnableIfAlternative<T>>
+    BasicShape& operator=(T&& shape)
+    {
+        using TAlternative = std::decay_t<T>;
+
+        if constexpr ((... || std::is_same_v<TAlternative, TShapes>))
+        {
+            if (auto* current = std::get_if<TAlternative>(&shape_))
+                *current = std::forward<T>(shape);
+            else
+                shape_.template emplace<TAlternative>(std::forward<T>(shape));
+        }
+        else
+        {
+            shape_ = std::forward<T>(shape);
+        }
 
         return *this;
     }
 
+    template <typename T, typename... TArgs>
+    T& emplace(TArgs&&... args)
+    {
+        if constexpr (std::is_constructible_v<T, TArgs...>)
+            return shape_.template emplace<T>(std::forward<TArgs>(args)...);
+        else
+            return shape_.template emplace<T>(T{std::forward<TArgs>(args)...});
+    }
+
     void draw() const
     {
-        std::visit([](const auto& s) { s.draw(); }, shape_);
+        fast_visit([](const auto& s) { s.draw(); }, shape_);
+    }
+
+    double area() const
+    {
+        return fast_visit(calculate_area, shape_);
+    }
+
+    const TShape& get() const noexcept
+    {
+        return shape_;
+    }
+};
+
+using Shape = BasicShape<Circle, Rectangle, Square>;
+
+// list of shapes constructed in place - no temporary Shape is copied or moved
+template <typename... TShapes>
+class BasicShapeList
+{
+    std::vector<BasicShape<TShapes...>> shapes_;
+
+public:
+    void reserve(size_t capacity)
+    {
+        shapes_.reserve(capacity);
+    }
+
+    template <typename T, typename... TArgs>
+    BasicShape<TShapes...>& emplace_back(TArgs&&... args)
+    {
+        return shapes_.emplace_back(std::in_place_type<T>, std::forward<TArgs>(args)...);
+    }
+
+    void push_back(BasicShape<TShapes...> shape)
+    {
+        shapes_.push_back(std::move(shape));
+    }
+
+    void clear() noexcept
+    {
+        shapes_.clear();
+    }
+
+    size_t size() const noexcept
+    {
+        return shapes_.size();
+    }
+
+    size_t capacity() const noexcept
+    {
+        return shapes_.capacity();
+    }
+
+    BasicShape<TShapes...>& operator[](size_t index)
+    {
+        return shapes_[index];
+    }
+
+    auto begin() noexcept
+    {
+        return shapes_.begin();
+    }
+
+    auto end() noexcept
+    {
+        return shapes_.end();
+    }
+
+    auto begin() const noexcept
+    {
+        return shapes_.begin();
+    }
+
+    auto end() const noexcept
+    {
+        return shapes_.end();
     }
 };
 
+using ShapeList = BasicShapeList<Circle, Rectangle, Square>;
+
 TEST_CASE("polymorphism with variant")
 {
     Shape s1 = Circle{10};
@@ -152,3 +240,545 @@ TEST_CASE("polymorphism with variant")
     s1.draw();
 }
 
+namespace
+{
+    vector<variant<Circle, Rectangle, Square>> make_random_shapes(size_t count)
+    {
+        std::mt19937 rnd_gen{42};
+        std::uniform_int_distribution<int> type_distr{0, 2};
+        std::uniform_int_distribution<int> size_distr{1, 100};
+
+        vector<variant<Circle, Rectangle, Square>> shapes;
+        shapes.reserve(count);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            switch (type_distr(rnd_gen))
+            {
+                case 0:
+                    shapes.push_back(Circle{size_distr(rnd_gen)});
+                    break;
+                case 1:
+                    shapes.push_back(Rectangle{size_distr(rnd_gen), size_distr(rnd_gen)});
+                    break;
+                default:
+                    shapes.push_back(Square{size_distr(rnd_gen)});
+            }
+        }
+
+        return shapes;
+    }
+}
+
+TEST_CASE("ShapeCollection - structure of arrays")
+{
+    Shapes shapes;
+    shapes.push_back(Circle{1});
+    shapes.push_back(Square{10});
+    shapes.push_back(variant<Circle, Rectangle, Square>{Rectangle{10, 1}});
+    shapes.push_back(Circle{2});
+
+    REQUIRE(shapes.size() == 4);
+    REQUIRE(shapes.all<Circle>().size() == 2);
+    REQUIRE(shapes.all<Rectangle>().size() == 1);
+
+    SECTION("total area")
+    {
+        REQUIRE_THAT(shapes.total_area(), Catch::Matchers::WithinRel(5 * pi<double> + 110, 1e-12));
+    }
+
+    SECTION("variant-style view")
+    {
+        double total_area{};
+        int circles{};
+
+        shapes.visit_all(overload{
+            [&](const Circle& c) { total_area += calculate_area(c); ++circles; },
+            [&](const auto& s) { total_area += calculate_area(s); }});
+
+        REQUIRE(circles == 2);
+        REQUIRE_THAT(total_area, Catch::Matchers::WithinRel(shapes.total_area(), 1e-12));
+    }
+
+    SECTION("same result as visiting vector of variants")
+    {
+        const auto variant_shapes = make_random_shapes(10'000);
+
+        Shapes collection;
+        double total_area{};
+        for (const auto& shp : variant_shapes)
+        {
+            collection.push_back(shp);
+            total_area += std::visit(calculate_area, shp);
+        }
+
+        REQUIRE_THAT(collection.total_area(), Catch::Matchers::WithinRel(total_area, 1e-9));
+    }
+}
+
+TEST_CASE("total area - benchmark", "[.benchmark]")
+{
+    const auto variant_shapes = make_random_shapes(10'000'000);
+
+    Shapes collection;
+    for (const auto& shp : variant_shapes)
+        collection.push_back(shp);
+
+    BENCHMARK("vector<variant> + std::visit")
+    {
+        double total_area{};
+        for (const auto& shp : variant_shapes)
+            total_area += std::visit(calculate_area, shp);
+        return total_area;
+    };
+
+    BENCHMARK("ShapeCollection - type-homogeneous kernels")
+    {
+        return collection.total_area();
+    };
+}
+
+TEST_CASE("fast_visit")
+{
+    using Shape = variant<Circle, Rectangle, Square>;
+
+    SECTION("same results as std::visit")
+    {
+        for (const Shape& shp : make_random_shapes(1'000))
+        {
+            REQUIRE(fast_visit(calculate_area, shp) == std::visit(calculate_area, shp));
+        }
+    }
+
+    SECTION("visitor gets access to the stored alternative")
+    {
+        Shape shp = Rectangle{1, 2};
+
+        fast_visit(overload{
+                       [](Rectangle& r) { r.width = 10; },
+                       [](auto&) {}},
+            shp);
+
+        REQUIRE(std::get<Rectangle>(shp).width == 10);
+
+        Rectangle&& moved = fast_visit(overload{
+                                           [](Rectangle&& r) -> Rectangle&& { return std::move(r); },
+                                           [](auto&&) -> Rectangle&& { throw std::bad_variant_access{}; }},
+            std::move(shp));
+        REQUIRE(moved.height == 2);
+    }
+
+    SECTION("result without default constructor")
+    {
+        struct Area
+        {
+            explicit Area(double value)
+                : value{value}
+            {
+            }
+
+            double value;
+        };
+
+        Shape shp = Square{3};
+
+        const Area area = fast_visit([](const auto& s) { return Area{calculate_area(s)}; }, shp);
+        REQUIRE(area.value == 9.0);
+    }
+
+    SECTION("many variants are forwarded to std::visit")
+    {
+        std::variant<int, double> v1 = 2;
+        std::variant<int, double> v2 = 1.5;
+
+        auto result = fast_visit([](auto a, auto b) -> double { return a * b; }, v1, v2);
+        REQUIRE(result == 3.0);
+    }
+
+    SECTION("constexpr")
+    {
+        constexpr std::variant<int, char> v = 'a';
+        static_assert(fast_visit([](auto x) { return static_cast<int>(x); }, v) == 97);
+    }
+}
+
+// code size of the same loops: codegen/ target variant-ex_codegen_size
+TEST_CASE("fast_visit - benchmark", "[.benchmark]")
+{
+    const auto shapes = make_random_shapes(10'000'000);
+
+    BENCHMARK("std::visit")
+    {
+        double total_area{};
+        for (const auto& shp : shapes)
+            total_area += std::visit(calculate_area, shp);
+        return total_area;
+    };
+
+    BENCHMARK("fast_visit")
+    {
+        double total_area{};
+        for (const auto& shp : shapes)
+            total_area += fast_visit(calculate_area, shp);
+        return total_area;
+    };
+}
+
+TEST_CASE("parallel area - deterministic result")
+{
+    const auto shapes = make_random_shapes(1'000'000);
+    auto area_of = [](const auto& shp) { return fast_visit(calculate_area, shp); };
+
+    const double reference = deterministic_transform_reduce(begin(shapes), end(shapes), area_of, 1);
+
+    SECTION("result is pinned across thread counts")
+    {
+        for (unsigned int num_threads : {2U, 3U, 4U, 7U, 8U, 16U, 64U})
+        {
+            REQUIRE(deterministic_transform_reduce(begin(shapes), end(shapes), area_of, num_threads) == reference);
+        }
+    }
+
+    SECTION("result is close to the serial sum")
+    {
+        double total_area{};
+        for (const auto& shp : shapes)
+            total_area += std::visit(calculate_area, shp);
+
+        REQUIRE_THAT(reference, Catch::Matchers::WithinRel(total_area, 1e-12));
+    }
+
+    SECTION("compensated summation")
+    {
+        std::vector<double> values = {1.0, 1e100, 1.0, -1e100};
+        auto identity = [](double x) { return x; };
+
+        REQUIRE(deterministic_transform_reduce(begin(values), end(values), identity, 4) == 2.0);
+    }
+
+    SECTION("empty range")
+    {
+        std::vector<variant<Circle, Rectangle, Square>> no_shapes;
+        REQUIRE(deterministic_transform_reduce(begin(no_shapes), end(no_shapes), area_of) == 0.0);
+    }
+}
+
+TEST_CASE("parallel area - benchmark", "[.benchmark]")
+{
+    auto area_of = [](const auto& shp) { return fast_visit(calculate_area, shp); };
+
+    for (size_t size : {1'000'000, 10'000'000, 100'000'000})
+    {
+        const auto shapes = make_random_shapes(size);
+
+        BENCHMARK("serial loop - " + std::to_string(size) + " shapes")
+        {
+            double total_area{};
+            for (const auto& shp : shapes)
+                total_area += std::visit(calculate_area, shp);
+            return total_area;
+        };
+
+        BENCHMARK("deterministic_transform_reduce - " + std::to_string(size) + " shapes")
+        {
+            return deterministic_transform_reduce(begin(shapes), end(shapes), area_of);
+        };
+    }
+}
+
+namespace
+{
+    struct Tracked
+    {
+        static inline int copies{};
+        static inline int moves{};
+
+        int id;
+
+        Tracked(int id)
+            : id{id}
+        {
+        }
+
+        Tracked(const Tracked& other)
+            : id{other.id}
+        {
+            ++copies;
+        }
+
+        Tracked(Tracked&& other) noexcept
+            : id{other.id}
+        {
+            ++moves;
+        }
+
+        Tracked& operator=(const Tracked& other)
+        {
+            id = other.id;
+            ++copies;
+            return *this;
+        }
+
+        Tracked& operator=(Tracked&& other) noexcept
+        {
+            id = other.id;
+            ++moves;
+            return *this;
+        }
+
+        void draw() const
+        {
+            std::cout << "Drawing Tracked #" << id << "\n";
+        }
+
+        static void reset_counters()
+        {
+            copies = moves = 0;
+        }
+    };
+}
+
+TEST_CASE("Shape - in-place construction & move-aware assignment")
+{
+    using TrackedShape = BasicShape<Circle, Tracked>;
+
+    Tracked::reset_counters();
+
+    SECTION("emplace constructs the alternative in place")
+    {
+        TrackedShape shp = Circle{1};
+        Tracked& t = shp.emplace<Tracked>(42);
+
+        REQUIRE(t.id == 42);
+        REQUIRE(Tracked::copies == 0);
+        REQUIRE(Tracked::moves == 0);
+
+        Shape aggregate_shp = Circle{1};
+        Rectangle& r = aggregate_shp.emplace<Rectangle>(10, 20);
+        REQUIRE(r.height == 20);
+    }
+
+    SECTION("in_place_type constructor")
+    {
+        TrackedShape shp{std::in_place_type<Tracked>, 665};
+
+        REQUIRE(std::get<Tracked>(shp.get()).id == 665);
+        REQUIRE(Tracked::copies == 0);
+        REQUIRE(Tracked::moves == 0);
+    }
+
+    SECTION("rvalue assignment moves")
+    {
+        TrackedShape shp = Circle{1};
+        shp = Tracked{1};
+
+        REQUIRE(Tracked::copies == 0);
+        REQUIRE(Tracked::moves == 1);
+    }
+
+    SECTION("lvalue assignment copies")
+    {
+        TrackedShape shp = Circle{1};
+        Tracked t{1};
+        shp = t;
+
+        REQUIRE(Tracked::copies == 1);
+        REQUIRE(Tracked::moves == 0);
+
+        shp = t; // same alternative - copy assignment
+        REQUIRE(Tracked::copies == 2);
+        REQUIRE(Tracked::moves == 0);
+    }
+
+    SECTION("copy of a non-const Shape uses copy constructor")
+    {
+        Shape s1 = Square{2};
+        Shape s2 = s1;
+
+        REQUIRE(s2.area() == 4.0);
+    }
+}
+
+TEST_CASE("ShapeList - shapes constructed in place")
+{
+    using TrackedShapeList = BasicShapeList<Circle, Tracked>;
+
+    Tracked::reset_counters();
+
+    TrackedShapeList shapes;
+    shapes.reserve(100);
+
+    for (int i = 0; i < 100; ++i)
+        shapes.emplace_back<Tracked>(i);
+
+    REQUIRE(shapes.size() == 100);
+    REQUIRE(shapes.capacity() == 100); // no reallocation
+    REQUIRE(Tracked::copies == 0);
+    REQUIRE(Tracked::moves == 0);
+
+    ShapeList scene;
+    scene.emplace_back<Circle>(1);
+    scene.emplace_back<Rectangle>(10, 1);
+    scene.push_back(Square{10});
+
+    double total_area{};
+    for (const auto& shp : scene)
+        total_area += shp.area();
+
+    REQUIRE_THAT(total_area, Catch::Matchers::WithinRel(113.14, 0.01));
+}
+
+TEST_CASE("scene rebuild - benchmark", "[.benchmark]")
+{
+    constexpr int size = 1'000'000;
+
+    ShapeList scene;
+    scene.reserve(size);
+    for (int i = 0; i < size; ++i)
+        scene.emplace_back<Circle>(i);
+
+    BENCHMARK("reassign - operator=(const T&)")
+    {
+        const Rectangle r{10, 20};
+        for (auto& shp : scene)
+            shp = r;
+        return scene[size - 1].area();
+    };
+
+    BENCHMARK("reassign - emplace<T>")
+    {
+        int i{};
+        for (auto& shp : scene)
+            shp.emplace<Rectangle>(++i, 20);
+        return scene[size - 1].area();
+    };
+
+    BENCHMARK("rebuild - vector<Shape>::push_back without reserve")
+    {
+        std::vector<Shape> shapes;
+        for (int i = 0; i < size; ++i)
+            shapes.push_back(Shape{Square{i}});
+        return shapes.size();
+    };
+
+    BENCHMARK("rebuild - ShapeList::reserve + emplace_back")
+    {
+        ShapeList shapes;
+        shapes.reserve(size);
+        for (int i = 0; i < size; ++i)
+            shapes.emplace_back<Square>(i);
+        return shapes.size();
+    };
+}
+
+namespace
+{
+    // redirects std::cout for the lifetime of the object
+    class CoutRedirect
+    {
+        std::streambuf* original_;
+
+    public:
+        explicit CoutRedirect(std::streambuf* target)
+            : original_{std::cout.rdbuf(target)}
+        {
+        }
+
+        CoutRedirect(const CoutRedirect&) = delete;
+        CoutRedirect& operator=(const CoutRedirect&) = delete;
+
+        ~CoutRedirect()
+        {
+            std::cout.rdbuf(original_);
+        }
+    };
+
+    class NullBuffer : public std::streambuf
+    {
+    protected:
+        int overflow(int c) override
+        {
+            return c;
+        }
+
+        std::streamsize xsputn(const char*, std::streamsize count) override
+        {
+            return count;
+        }
+    };
+}
+
+TEST_CASE("DrawBuffer - batch rendering")
+{
+    SECTION("same text as Shape::draw()")
+    {
+        const std::vector<variant<Circle, Rectangle, Square>> shapes = {
+            Circle{1}, Rectangle{10, -1}, Square{std::numeric_limits<int>::min()}, Circle{std::numeric_limits<int>::max()},
+            Rectangle{std::numeric_limits<int>::min(), std::numeric_limits<int>::min()}};
+
+        std::ostringstream expected;
+        {
+            CoutRedirect redirect{expected.rdbuf()};
+            for (const auto& shp : shapes)
+                std::visit([](const auto& s) { s.draw(); }, shp);
+        }
+
+        DrawBuffer buffer{16};
+        for (const auto& shp : shapes)
+            std::visit([&buffer](const auto& s) { buffer.draw(s); }, shp);
+
+        REQUIRE(buffer.view() == expected.str());
+
+        std::ostringstream out;
+        buffer.flush(out);
+        REQUIRE(out.str() == expected.str());
+        REQUIRE(buffer.view().empty());
+    }
+
+    SECTION("type-grouped ShapeCollection")
+    {
+        Shapes shapes;
+        shapes.push_back(Square{2});
+        shapes.push_back(Circle{1});
+        shapes.push_back(Square{3});
+
+        DrawBuffer buffer;
+        buffer.draw_all(shapes);
+
+        REQUIRE(buffer.view() == "Drawing Circle with r: 1\nDrawing Square with size: 2\nDrawing Square with size: 3\n");
+    }
+}
+
+TEST_CASE("batch rendering - benchmark", "[.benchmark]")
+{
+    const auto variant_shapes = make_random_shapes(1'000'000);
+
+    Shapes collection;
+    for (const auto& shp : variant_shapes)
+        collection.push_back(shp);
+
+    NullBuffer null_buffer;
+    std::ostream null_stream{&null_buffer};
+    CoutRedirect redirect{&null_buffer};
+
+    BENCHMARK("std::visit + draw() - 1M lines")
+    {
+        for (const auto& shp : variant_shapes)
+            std::visit([](const auto& s) { s.draw(); }, shp);
+    };
+
+    DrawBuffer buffer{variant_shapes.size() * 64};
+
+    BENCHMARK("DrawBuffer - vector<variant> - 1M lines")
+    {
+        for (const auto& shp : variant_shapes)
+            fast_visit([&buffer](const auto& s) { buffer.draw(s); }, shp);
+        buffer.flush(null_stream);
+    };
+
+    BENCHMARK("DrawBuffer - type-grouped ShapeCollection - 1M lines")
+    {
+        buffer.draw_all(collection);
+        buffer.flush(null_stream);
+    };
+}
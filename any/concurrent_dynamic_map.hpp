@@ -0,0 +1,96 @@
+#ifndef CONCURRENT_DYNAMIC_MAP_HPP
+#define CONCURRENT_DYNAMIC_MAP_HPP
+
+#include "flat_dynamic_map.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <utility>
+
+// read-mostly map with RCU-style snapshots: readers work on an immutable snapshot,
+// writers copy it, apply a batch of updates and publish the copy atomically
+template <typename TMap = FlatDynamicMap<>>
+class ConcurrentDynamicMap
+{
+    std::shared_ptr<const TMap> snapshot_ = std::make_shared<const TMap>(); // accessed with std::atomic_load/store
+    std::atomic<uint64_t> version_{0};
+    std::mutex mtx_writers_;
+
+public:
+    using Snapshot = std::shared_ptr<const TMap>;
+
+    // per-thread handle - checks one atomic counter per access and refreshes
+    // its cached snapshot only after a writer published a new one
+    class Reader
+    {
+        const ConcurrentDynamicMap* map_;
+        Snapshot snapshot_;
+        uint64_t version_;
+
+    public:
+        explicit Reader(const ConcurrentDynamicMap& map)
+            : map_{&map}
+            , version_{map.version_.load(std::memory_order_acquire)}
+        {
+            snapshot_ = map.snapshot();
+        }
+
+        const TMap& current()
+        {
+            if (const uint64_t version = map_->version_.load(std::memory_order_acquire); version != version_)
+            {
+                version_ = version;
+                snapshot_ = map_->snapshot();
+            }
+
+            return *snapshot_;
+        }
+
+        template <typename T>
+        T get(std::string_view key)
+        {
+            return current().template get<T>(key);
+        }
+    };
+
+    Snapshot snapshot() const
+    {
+        return std::atomic_load(&snapshot_);
+    }
+
+    Reader reader() const
+    {
+        return Reader{*this};
+    }
+
+    template <typename T>
+    T get(std::string_view key) const
+    {
+        return snapshot()->template get<T>(key);
+    }
+
+    // f(TMap&) applies a batch of updates to a private copy that is published afterwards
+    template <typename F>
+    void update(F&& f)
+    {
+        std::lock_guard lk{mtx_writers_};
+
+        auto next = std::make_shared<TMap>(*std::atomic_load(&snapshot_));
+        std::forward<F>(f)(*next);
+
+        std::atomic_store(&snapshot_, Snapshot{std::move(next)});
+        version_.fetch_add(1, std::memory_order_release);
+    }
+
+    template <typename T>
+    bool insert(std::string key, T value)
+    {
+        bool inserted{};
+        update([&](TMap& map) { inserted = map.insert(std::move(key), std::move(value)); });
+        return inserted;
+    }
+};
+
+#endif
@@ -0,0 +1,343 @@
+#ifndef DYNAMIC_MAP_SERIALIZATION_HPP
+#define DYNAMIC_MAP_SERIALIZATION_HPP
+
+#include "flat_dynamic_map.hpp"
+
+#include <algorithm>
+#include <any>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// Binary layout (little-endian host byte order, every offset relative to the start of the buffer):
+//   Header                          magic "DMAP", format version, number of entries
+//   EntryRecord[entry_count]        sorted by key - binary search works directly on the buffer
+//   payload                         values aligned to 8 bytes, keys
+// A buffer can be memory-mapped and queried in place with DynamicMapView.
+
+// registered-type table: specialize for every type that can be serialized
+// (trivially copyable types are stored as raw bytes, std::string as characters)
+template <typename T>
+struct SerializedType;
+
+template <>
+struct SerializedType<int>
+{
+    static constexpr uint32_t id = 1;
+};
+
+template <>
+struct SerializedType<double>
+{
+    static constexpr uint32_t id = 2;
+};
+
+template <>
+struct SerializedType<std::string>
+{
+    static constexpr uint32_t id = 3;
+};
+
+namespace Serialization
+{
+    constexpr char magic[4] = {'D', 'M', 'A', 'P'};
+    constexpr uint32_t format_version = 1;
+    constexpr size_t value_alignment = 8;
+
+    struct Header
+    {
+        char magic[4];
+        uint32_t version;
+        uint32_t entry_count;
+        uint32_t reserved;
+    };
+
+    struct EntryRecord
+    {
+        uint32_t key_offset;
+        uint32_t key_size;
+        uint32_t type_id;
+        uint32_t value_offset;
+        uint32_t value_size;
+    };
+
+    template <typename T>
+    constexpr bool is_string_v = std::is_same_v<T, std::string>;
+
+    template <typename T>
+    bool append_value(const SmallAny<>& value, uint32_t& type_id, std::string& bytes)
+    {
+        static_assert(is_string_v<T> || std::is_trivially_copyable_v<T>, "only trivially copyable types and std::string can be serialized");
+
+        const T* item = small_any_cast<T>(&value);
+
+        if (!item)
+            return false;
+
+        type_id = SerializedType<T>::id;
+
+        if constexpr (is_string_v<T>)
+            bytes.assign(*item);
+        else
+            bytes.assign(reinterpret_cast<const char*>(item), sizeof(T));
+
+        return true;
+    }
+
+    inline size_t align_up(size_t offset) noexcept
+    {
+        return (offset + value_alignment - 1) / value_alignment * value_alignment;
+    }
+}
+
+// TTypes - types that may be stored in the map; a value of other type throws invalid_argument
+template <typename... TTypes>
+std::vector<char> serialize(const FlatDynamicMap<>& map)
+{
+    using namespace Serialization;
+
+    struct Item
+    {
+        std::string_view key;
+        uint32_t type_id;
+        std::string bytes;
+    };
+
+    std::vector<Item> items;
+    items.reserve(map.size());
+
+    map.for_each([&items](std::string_view key, const auto& value) {
+        Item item{key, 0, {}};
+
+        if (!(... || append_value<TTypes>(value, item.type_id, item.bytes)))
+            throw std::invalid_argument{"type of value '" + std::string{key} + "' is not registered for serialization"};
+
+        items.push_back(std::move(item));
+    });
+
+    std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) { return a.key < b.key; });
+
+    // offsets, sizes and entry count are stored as 32-bit values
+    constexpr size_t max_size = std::numeric_limits<uint32_t>::max();
+    const auto check_size = [](size_t value) {
+        if (value > max_size)
+            throw std::length_error{"DynamicMap too large for serialization - limit is 4 GiB"};
+    };
+
+    check_size(items.size());
+    size_t size = sizeof(Header) + items.size() * sizeof(EntryRecord);
+    check_size(size);
+
+    std::vector<EntryRecord> records;
+    records.reserve(items.size());
+
+    for (const auto& item : items)
+    {
+        const size_t value_offset = align_up(size);
+        const size_t key_offset = value_offset + item.bytes.size();
+        size = key_offset + item.key.size();
+        check_size(size);
+
+        records.push_back(EntryRecord{static_cast<uint32_t>(key_offset), static_cast<uint32_t>(item.key.size()),
+            item.type_id, static_cast<uint32_t>(value_offset), static_cast<uint32_t>(item.bytes.size())});
+    }
+
+    std::vector<char> buffer(size);
+
+    Header header{{}, format_version, static_cast<uint32_t>(items.size()), 0};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    std::memcpy(buffer.data(), &header, sizeof(header));
+    std::memcpy(buffer.data() + sizeof(Header), records.data(), records.size() * sizeof(EntryRecord));
+
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        std::memcpy(buffer.data() + records[i].value_offset, items[i].bytes.data(), items[i].bytes.size());
+        std::memcpy(buffer.data() + records[i].key_offset, items[i].key.data(), items[i].key.size());
+    }
+
+    return buffer;
+}
+
+// read-only view of a serialized map - nothing is decoded up front,
+// get() looks the key up in place and copies out only the requested value
+class DynamicMapView
+{
+    const char* data_;
+    size_t size_;
+    uint32_t entry_count_;
+
+    Serialization::EntryRecord record(size_t index) const noexcept
+    {
+        Serialization::EntryRecord rec;
+        std::memcpy(&rec, data_ + sizeof(Serialization::Header) + index * sizeof(rec), sizeof(rec));
+        return rec;
+    }
+
+    std::string_view key_at(const Serialization::EntryRecord& rec) const noexcept
+    {
+        return {data_ + rec.key_offset, rec.key_size};
+    }
+
+    std::optional<Serialization::EntryRecord> lookup(std::string_view key) const noexcept
+    {
+        size_t first = 0;
+        size_t last = entry_count_;
+
+        while (first < last)
+        {
+            const size_t middle = first + (last - first) / 2;
+            const auto rec = record(middle);
+            const std::string_view middle_key = key_at(rec);
+
+            if (middle_key == key)
+                return rec;
+
+            if (middle_key < key)
+                first = middle + 1;
+            else
+                last = middle;
+        }
+
+        return std::nullopt;
+    }
+
+    Serialization::EntryRecord find(std::string_view key) const
+    {
+        if (const auto rec = lookup(key))
+            return *rec;
+
+        throw std::out_of_range{"key not found"};
+    }
+
+    template <typename T>
+    Serialization::EntryRecord find_typed(std::string_view key) const
+    {
+        const auto rec = find(key);
+
+        if (rec.type_id != SerializedType<T>::id)
+            throw std::bad_any_cast{};
+
+        return rec;
+    }
+
+public:
+    DynamicMapView(const char* data, size_t size)
+        : data_{data}
+        , size_{size}
+    {
+        using namespace Serialization;
+
+        Header header;
+        if (size_ < sizeof(header))
+            throw std::runtime_error{"buffer too small for DynamicMap header"};
+
+        std::memcpy(&header, data_, sizeof(header));
+        if (std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != format_version)
+            throw std::runtime_error{"not a serialized DynamicMap"};
+
+        entry_count_ = header.entry_count;
+        if ((size_ - sizeof(Header)) / sizeof(EntryRecord) < entry_count_)
+            throw std::runtime_error{"corrupted DynamicMap - entry table out of range"};
+
+        for (size_t i = 0; i < entry_count_; ++i)
+        {
+            const auto rec = record(i);
+
+            if (uint64_t{rec.key_offset} + rec.key_size > size_ || uint64_t{rec.value_offset} + rec.value_size > size_)
+                throw std::runtime_error{"corrupted DynamicMap - entry out of range"};
+        }
+    }
+
+    explicit DynamicMapView(const std::vector<char>& buffer)
+        : DynamicMapView(buffer.data(), buffer.size())
+    {
+    }
+
+    size_t size() const noexcept
+    {
+        return entry_count_;
+    }
+
+    bool contains(std::string_view key) const noexcept
+    {
+        return lookup(key).has_value();
+    }
+
+    template <typename T>
+    T get(std::string_view key) const
+    {
+        if constexpr (std::is_same_v<T, std::string_view> || std::is_same_v<T, std::string>)
+        {
+            const auto rec = find_typed<std::string>(key);
+            return T{data_ + rec.value_offset, rec.value_size};
+        }
+        else
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+
+            const auto rec = find_typed<T>(key);
+            if (rec.value_size != sizeof(T))
+                throw std::runtime_error{"corrupted DynamicMap - value size mismatch"};
+
+            T value;
+            std::memcpy(&value, data_ + rec.value_offset, sizeof(T));
+            return value;
+        }
+    }
+
+    // pointer into the buffer - requires the buffer to be aligned at least like T (mmap'ed pages are);
+    // nullptr for a misaligned value
+    template <typename T>
+    const T* get_in_place(std::string_view key) const
+    {
+        static_assert(std::is_trivially_copyable_v<T> && alignof(T) <= Serialization::value_alignment);
+
+        const auto rec = find_typed<T>(key);
+        if (rec.value_size != sizeof(T))
+            throw std::runtime_error{"corrupted DynamicMap - value size mismatch"};
+
+        const char* ptr = data_ + rec.value_offset;
+        if (reinterpret_cast<uintptr_t>(ptr) % alignof(T) != 0)
+            return nullptr;
+
+        return reinterpret_cast<const T*>(ptr);
+    }
+
+    // calls f(key, type_id) for every entry in key order
+    template <typename F>
+    void for_each_entry(F&& f) const
+    {
+        for (size_t i = 0; i < entry_count_; ++i)
+        {
+            const auto rec = record(i);
+            f(key_at(rec), rec.type_id);
+        }
+    }
+};
+
+// naive per-entry decode of the whole buffer into a map
+template <typename... TTypes>
+FlatDynamicMap<> deserialize(const DynamicMapView& view)
+{
+    FlatDynamicMap<> map{view.size()};
+
+    view.for_each_entry([&](std::string_view key, uint32_t type_id) {
+        if (!(... || (type_id == SerializedType<TTypes>::id)))
+            throw std::invalid_argument{"type of value '" + std::string{key} + "' is not registered for deserialization"};
+
+        const bool inserted = (... || (type_id == SerializedType<TTypes>::id && map.insert(std::string{key}, view.get<TTypes>(key))));
+
+        if (!inserted)
+            throw std::runtime_error{"corrupted DynamicMap - duplicate key '" + std::string{key} + "'"};
+    });
+
+    return map;
+}
+
+#endif
@@ -0,0 +1,250 @@
+#ifndef FLAT_DYNAMIC_MAP_HPP
+#define FLAT_DYNAMIC_MAP_HPP
+
+#include "small_any.hpp"
+
+#include <cassert>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// DynamicMap on an open-addressing table (linear probing, power-of-two capacity)
+// with string_view lookup and values kept in SmallAny;
+// entries live in an append-only array, so their indices are stable and can be handed out as typed keys
+template <size_t InlineSize = 32>
+class FlatDynamicMap
+{
+public:
+    using Value = SmallAny<InlineSize>;
+
+    // handle to an entry of type T - resolved once, then every access is an indexed load;
+    // valid for the map that resolved it (and copies of that map)
+    template <typename T>
+    class Key
+    {
+        size_t index_;
+
+        explicit Key(size_t index) noexcept
+            : index_{index}
+        {
+        }
+
+        friend class FlatDynamicMap;
+
+    public:
+        size_t index() const noexcept
+        {
+            return index_;
+        }
+    };
+
+private:
+    struct Entry
+    {
+        std::string key;
+        Value value;
+    };
+
+    struct Slot
+    {
+        size_t hash{};
+        size_t entry{}; // index into entries_ + 1, 0 - empty slot
+    };
+
+    std::vector<Entry> entries_;
+    std::vector<Slot> slots_;
+
+    static size_t hash_of(std::string_view key) noexcept
+    {
+        return std::hash<std::string_view>{}(key);
+    }
+
+    size_t mask() const noexcept
+    {
+        return slots_.size() - 1;
+    }
+
+    // index of the slot holding key or of the empty slot where it belongs
+    size_t probe(std::string_view key, size_t hash) const noexcept
+    {
+        size_t index = hash & mask();
+
+        while (slots_[index].entry != 0 && (slots_[index].hash != hash || entries_[slots_[index].entry - 1].key != key))
+            index = (index + 1) & mask();
+
+        return index;
+    }
+
+    void rehash(size_t new_capacity)
+    {
+        std::vector<Slot> old_slots(new_capacity);
+        old_slots.swap(slots_);
+
+        for (const auto& slot : old_slots)
+        {
+            if (slot.entry != 0)
+            {
+                size_t index = slot.hash & mask();
+                while (slots_[index].entry != 0)
+                    index = (index + 1) & mask();
+
+                slots_[index] = slot;
+            }
+        }
+    }
+
+    const Entry* find_entry(std::string_view key) const noexcept
+    {
+        if (slots_.empty())
+            return nullptr;
+
+        const Slot& slot = slots_[probe(key, hash_of(key))];
+        return slot.entry != 0 ? &entries_[slot.entry - 1] : nullptr;
+    }
+
+    template <typename T>
+    const T& value_at(const Key<T>& key) const noexcept
+    {
+        assert(key.index_ < entries_.size() && "key resolved in other map");
+        return entries_[key.index_].value.template get_unchecked<T>();
+    }
+
+    template <typename T>
+    T& value_at(const Key<T>& key) noexcept
+    {
+        assert(key.index_ < entries_.size() && "key resolved in other map");
+        return entries_[key.index_].value.template get_unchecked<T>();
+    }
+
+public:
+    FlatDynamicMap() = default;
+
+    explicit FlatDynamicMap(size_t expected_size)
+    {
+        reserve(expected_size);
+    }
+
+    void reserve(size_t expected_size)
+    {
+        size_t capacity = 8;
+        while (capacity < 2 * expected_size) // load factor <= 0.5
+            capacity *= 2;
+
+        if (capacity > slots_.size())
+            rehash(capacity);
+
+        entries_.reserve(expected_size);
+    }
+
+    template <typename T>
+    bool insert(std::string key, T value)
+    {
+        if (2 * (entries_.size() + 1) > slots_.size())
+            reserve(entries_.size() + 1);
+
+        const size_t hash = hash_of(key);
+        Slot& slot = slots_[probe(key, hash)];
+
+        if (slot.entry != 0)
+            return false;
+
+        entries_.push_back(Entry{std::move(key), Value{std::move(value)}});
+        slot = Slot{hash, entries_.size()};
+
+        return true;
+    }
+
+    // a key can't change its type - typed keys would be invalidated
+    template <typename T>
+    void insert_or_assign(std::string key, T value)
+    {
+        if (const Entry* entry = find_entry(key))
+        {
+            if (!entry->value.template holds<T>())
+                throw std::bad_any_cast{};
+
+            entries_[entry - entries_.data()].value.template get_unchecked<T>() = std::move(value);
+        }
+        else
+        {
+            insert(std::move(key), std::move(value));
+        }
+    }
+
+    template <typename T>
+    T get(std::string_view key) const
+    {
+        const Entry* entry = find_entry(key);
+
+        if (!entry)
+            throw std::out_of_range{"key not found"};
+
+        return small_any_cast<T>(entry->value);
+    }
+
+    // the only place where the type is checked - throws bad_any_cast on mismatch
+    template <typename T>
+    Key<T> key(std::string_view name) const
+    {
+        const Entry* entry = find_entry(name);
+
+        if (!entry)
+            throw std::out_of_range{"key not found"};
+
+        if (!entry->value.template holds<T>())
+            throw std::bad_any_cast{};
+
+        return Key<T>{static_cast<size_t>(entry - entries_.data())};
+    }
+
+    // inserts the entry if it doesn't exist and resolves a typed key for it
+    template <typename T>
+    Key<T> register_key(std::string name, T initial_value)
+    {
+        insert(name, std::move(initial_value));
+
+        return key<T>(name);
+    }
+
+    // no hashing and no type check - the type was verified when the key was resolved
+    template <typename T>
+    const T& get(const Key<T>& key) const noexcept
+    {
+        return value_at(key);
+    }
+
+    template <typename T>
+    void set(const Key<T>& key, T value)
+    {
+        value_at(key) = std::move(value);
+    }
+
+    const Value* find(std::string_view key) const noexcept
+    {
+        const Entry* entry = find_entry(key);
+        return entry ? &entry->value : nullptr;
+    }
+
+    bool contains(std::string_view key) const noexcept
+    {
+        return find_entry(key) != nullptr;
+    }
+
+    size_t size() const noexcept
+    {
+        return entries_.size();
+    }
+
+    // calls f(key, value) for every entry in insertion order
+    template <typename F>
+    void for_each(F&& f) const
+    {
+        for (const auto& entry : entries_)
+            f(std::string_view{entry.key}, entry.value);
+    }
+};
+
+#endif
@@ -0,0 +1,267 @@
+#ifndef SMALL_ANY_HPP
+#define SMALL_ANY_HPP
+
+#include <any>
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+// std::any with configurable inline buffer - values up to BufferSize bytes
+// (with nothrow move) never touch the heap
+template <size_t BufferSize = 32>
+class SmallAny
+{
+    struct Operations
+    {
+        void (*destroy)(SmallAny&) noexcept;
+        void (*copy)(const SmallAny& source, SmallAny& target);
+        void (*move)(SmallAny& source, SmallAny& target) noexcept;
+        const std::type_info& (*type)() noexcept;
+    };
+
+    template <typename T>
+    static constexpr bool is_inline_v = sizeof(T) <= BufferSize
+        && alignof(std::max_align_t) % alignof(T) == 0
+        && std::is_nothrow_move_constructible_v<T>;
+
+    template <typename T>
+    struct InlineStorage
+    {
+        static T* get(SmallAny& a) noexcept
+        {
+            return std::launder(reinterpret_cast<T*>(&a.buffer_));
+        }
+
+        static const T* get(const SmallAny& a) noexcept
+        {
+            return std::launder(reinterpret_cast<const T*>(&a.buffer_));
+        }
+
+        template <typename... TArgs>
+        static void create(SmallAny& a, TArgs&&... args)
+        {
+            ::new (static_cast<void*>(&a.buffer_)) T(std::forward<TArgs>(args)...);
+        }
+
+        static void destroy(SmallAny& a) noexcept
+        {
+            get(a)->~T();
+        }
+
+        static void copy(const SmallAny& source, SmallAny& target)
+        {
+            create(target, *get(source));
+        }
+
+        static void move(SmallAny& source, SmallAny& target) noexcept
+        {
+            create(target, std::move(*get(source)));
+            destroy(source);
+        }
+    };
+
+    template <typename T>
+    struct HeapStorage
+    {
+        static T* get(SmallAny& a) noexcept
+        {
+            return static_cast<T*>(a.heap_);
+        }
+
+        static const T* get(const SmallAny& a) noexcept
+        {
+            return static_cast<const T*>(a.heap_);
+        }
+
+        template <typename... TArgs>
+        static void create(SmallAny& a, TArgs&&... args)
+        {
+            a.heap_ = new T(std::forward<TArgs>(args)...);
+        }
+
+        static void destroy(SmallAny& a) noexcept
+        {
+            delete get(a);
+        }
+
+        static void copy(const SmallAny& source, SmallAny& target)
+        {
+            create(target, *get(source));
+        }
+
+        static void move(SmallAny& source, SmallAny& target) noexcept
+        {
+            target.heap_ = source.heap_;
+        }
+    };
+
+    template <typename T>
+    using Storage = std::conditional_t<is_inline_v<T>, InlineStorage<T>, HeapStorage<T>>;
+
+    template <typename T>
+    static const std::type_info& type_of() noexcept
+    {
+        return typeid(T);
+    }
+
+    // one instance per stored type - its address identifies the type
+    template <typename T>
+    static inline constexpr Operations operations_for{
+        &Storage<T>::destroy, &Storage<T>::copy, &Storage<T>::move, &type_of<T>};
+
+    union
+    {
+        std::aligned_storage_t<BufferSize, alignof(std::max_align_t)> buffer_;
+        void* heap_;
+    };
+
+    const Operations* operations_{};
+
+public:
+    SmallAny() noexcept = default;
+
+    template <typename T, typename TValue = std::decay_t<T>,
+        typename = std::enable_if_t<!std::is_same_v<TValue, SmallAny>>>
+    SmallAny(T&& value)
+    {
+        emplace<TValue>(std::forward<T>(value));
+    }
+
+    SmallAny(const SmallAny& other)
+    {
+        if (other.operations_)
+        {
+            other.operations_->copy(other, *this);
+            operations_ = other.operations_;
+        }
+    }
+
+    SmallAny(SmallAny&& other) noexcept
+    {
+        if (other.operations_)
+        {
+            other.operations_->move(other, *this);
+            operations_ = std::exchange(other.operations_, nullptr);
+        }
+    }
+
+    SmallAny& operator=(const SmallAny& other)
+    {
+        SmallAny temp(other);
+        *this = std::move(temp);
+        return *this;
+    }
+
+    SmallAny& operator=(SmallAny&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+
+            if (other.operations_)
+            {
+                other.operations_->move(other, *this);
+                operations_ = std::exchange(other.operations_, nullptr);
+            }
+        }
+
+        return *this;
+    }
+
+    template <typename T, typename = std::enable_if_t<!std::is_same_v<std::decay_t<T>, SmallAny>>>
+    SmallAny& operator=(T&& value)
+    {
+        emplace<std::decay_t<T>>(std::forward<T>(value));
+        return *this;
+    }
+
+    ~SmallAny()
+    {
+        reset();
+    }
+
+    template <typename T, typename... TArgs>
+    T& emplace(TArgs&&... args)
+    {
+        reset();
+        Storage<T>::create(*this, std::forward<TArgs>(args)...);
+        operations_ = &operations_for<T>;
+
+        return *Storage<T>::get(*this);
+    }
+
+    void reset() noexcept
+    {
+        if (operations_)
+        {
+            operations_->destroy(*this);
+            operations_ = nullptr;
+        }
+    }
+
+    bool has_value() const noexcept
+    {
+        return operations_ != nullptr;
+    }
+
+    const std::type_info& type() const noexcept
+    {
+        return operations_ ? operations_->type() : typeid(void);
+    }
+
+    template <typename T>
+    bool holds() const noexcept
+    {
+        return operations_ == &operations_for<T>;
+    }
+
+    // precondition: holds<T>()
+    template <typename T>
+    T& get_unchecked() noexcept
+    {
+        assert(holds<T>());
+        return *Storage<T>::get(*this);
+    }
+
+    template <typename T>
+    const T& get_unchecked() const noexcept
+    {
+        assert(holds<T>());
+        return *Storage<T>::get(*this);
+    }
+
+    template <typename T>
+    static constexpr bool stores_inline = is_inline_v<T>;
+};
+
+// type check is a pointer comparison - no type_info comparison
+template <typename T, size_t N>
+const T* small_any_cast(const SmallAny<N>* a) noexcept
+{
+    if (a && a->template holds<T>())
+        return &a->template get_unchecked<T>();
+
+    return nullptr;
+}
+
+template <typename T, size_t N>
+T* small_any_cast(SmallAny<N>* a) noexcept
+{
+    return const_cast<T*>(small_any_cast<T>(static_cast<const SmallAny<N>*>(a)));
+}
+
+template <typename T, size_t N>
+T small_any_cast(const SmallAny<N>& a)
+{
+    using TValue = std::remove_cv_t<std::remove_reference_t<T>>;
+
+    if (const TValue* value = small_any_cast<TValue>(&a))
+        return static_cast<T>(*value);
+
+    throw std::bad_any_cast{};
+}
+
+#endif
@@ -1,9 +1,22 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "concurrent_dynamic_map.hpp"
+#include "dynamic_map_serialization.hpp"
+#include "flat_dynamic_map.hpp"
+#include "small_any.hpp"
+
 #include <algorithm>
 #include <any>
+#include <atomic>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstring>
 #include <iostream>
+#include <memory>
 #include <numeric>
+#include <shared_mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include <map>
 
@@ -14,6 +27,12 @@ struct Data
     int a, b;
 };
 
+template <>
+struct SerializedType<Data>
+{
+    static constexpr uint32_t id = 100;
+};
+
 TEST_CASE("any")
 {
     std::any anything;
@@ -81,4 +100,509 @@ TEST_CASE("dynamic map")
     REQUIRE(dm.get<int>("age") == 42);
     REQUIRE(dm.get<std::string>("name") == "Jan");
     REQUIRE_THROWS_AS(dm.get<int>("name"), std::bad_any_cast);
-}
\ No newline at end of file
+}
+
+TEST_CASE("SmallAny")
+{
+    static_assert(SmallAny<>::stores_inline<int>);
+    static_assert(SmallAny<>::stores_inline<std::string>);
+    static_assert(SmallAny<>::stores_inline<std::vector<int>>);
+    static_assert(SmallAny<>::stores_inline<Data>);
+    static_assert(!SmallAny<8>::stores_inline<std::string>);
+
+    SmallAny<> anything;
+    REQUIRE(anything.has_value() == false);
+
+    anything = 42;
+    REQUIRE(small_any_cast<int>(anything) == 42);
+    REQUIRE(anything.type() == typeid(int));
+
+    anything = "text"s;
+    REQUIRE(small_any_cast<const std::string&>(anything) == "text");
+    REQUIRE_THROWS_AS(small_any_cast<int>(anything), std::bad_any_cast);
+    REQUIRE(small_any_cast<int>(&anything) == nullptr);
+
+    SECTION("copy & move - inline")
+    {
+        SmallAny<> copy = anything;
+        REQUIRE(small_any_cast<std::string>(copy) == "text");
+
+        SmallAny<> target = std::move(copy);
+        REQUIRE(small_any_cast<std::string>(target) == "text");
+        REQUIRE_FALSE(copy.has_value());
+    }
+
+    SECTION("copy & move - heap")
+    {
+        SmallAny<8> small = "a string that doesn't fit"s;
+        SmallAny<8> copy = small;
+        REQUIRE(small_any_cast<std::string>(copy) == "a string that doesn't fit");
+
+        SmallAny<8> target;
+        target = std::move(copy);
+        REQUIRE(small_any_cast<std::string>(target) == "a string that doesn't fit");
+        REQUIRE_FALSE(copy.has_value());
+    }
+
+    SECTION("destroys stored value")
+    {
+        auto ptr = std::make_shared<int>(1);
+        {
+            SmallAny<> a = ptr;
+            REQUIRE(ptr.use_count() == 2);
+            a = 3.14;
+            REQUIRE(ptr.use_count() == 1);
+            a = ptr;
+        }
+        REQUIRE(ptr.use_count() == 1);
+    }
+}
+
+TEST_CASE("FlatDynamicMap")
+{
+    FlatDynamicMap<> dm;
+
+    REQUIRE(dm.insert("age", 42));
+    REQUIRE(dm.insert("name", "Jan"s));
+    REQUIRE(dm.insert("data", Data{1, 2}));
+    REQUIRE_FALSE(dm.insert("age", 665));
+
+    REQUIRE(dm.size() == 3);
+    REQUIRE(dm.get<int>("age") == 42);
+    REQUIRE(dm.get<std::string>("name"sv) == "Jan");
+    REQUIRE(dm.get<Data>("data").b == 2);
+    REQUIRE_THROWS_AS(dm.get<int>("name"), std::bad_any_cast);
+    REQUIRE_THROWS_AS(dm.get<int>("unknown"), std::out_of_range);
+    REQUIRE(dm.contains("name"));
+    REQUIRE_FALSE(dm.contains("unknown"));
+
+    SECTION("growth keeps all entries")
+    {
+        for (int i = 0; i < 1000; ++i)
+            REQUIRE(dm.insert("key" + std::to_string(i), i));
+
+        for (int i = 0; i < 1000; ++i)
+            REQUIRE(dm.get<int>("key" + std::to_string(i)) == i);
+
+        REQUIRE(dm.size() == 1003);
+    }
+}
+
+TEST_CASE("FlatDynamicMap - typed keys")
+{
+    FlatDynamicMap<> dm;
+    dm.insert("name", "Jan"s);
+
+    const auto key_age = dm.register_key("age", 42);
+    const auto key_name = dm.key<std::string>("name");
+
+    REQUIRE(dm.get(key_age) == 42);
+    REQUIRE(dm.get(key_name) == "Jan");
+
+    SECTION("set through typed key")
+    {
+        dm.set(key_age, 43);
+
+        REQUIRE(dm.get(key_age) == 43);
+        REQUIRE(dm.get<int>("age") == 43);
+    }
+
+    SECTION("keys stay valid when map grows")
+    {
+        for (int i = 0; i < 1000; ++i)
+            dm.insert("key" + std::to_string(i), i);
+
+        REQUIRE(dm.get(key_age) == 42);
+        REQUIRE(dm.get(key_name) == "Jan");
+    }
+
+    SECTION("type is checked when key is resolved")
+    {
+        REQUIRE_THROWS_AS(dm.key<int>("name"), std::bad_any_cast);
+        REQUIRE_THROWS_AS(dm.register_key("name", 665), std::bad_any_cast);
+        REQUIRE_THROWS_AS(dm.key<int>("unknown"), std::out_of_range);
+    }
+
+    SECTION("registering existing key keeps its value")
+    {
+        const auto key = dm.register_key("age", 0);
+
+        REQUIRE(key.index() == key_age.index());
+        REQUIRE(dm.get(key) == 42);
+    }
+
+    static_assert(std::is_same_v<decltype(dm.get(key_name)), const std::string&>);
+    static_assert(!std::is_constructible_v<FlatDynamicMap<>::Key<int>, size_t>, "keys are created only by the map");
+}
+
+namespace
+{
+    std::vector<std::string> make_keys(size_t count)
+    {
+        std::vector<std::string> keys;
+        for (size_t i = 0; i < count; ++i)
+            keys.push_back("config.section." + std::to_string(i * 7919 % count));
+        return keys;
+    }
+}
+
+TEST_CASE("DynamicMap - benchmark", "[.benchmark]")
+{
+    const auto keys = make_keys(10'000);
+
+    BENCHMARK("DynamicMap - insert")
+    {
+        DynamicMap dm;
+        for (size_t i = 0; i < keys.size(); ++i)
+            dm.insert(keys[i], static_cast<int>(i));
+        return dm;
+    };
+
+    BENCHMARK("FlatDynamicMap - insert")
+    {
+        FlatDynamicMap<> dm;
+        for (size_t i = 0; i < keys.size(); ++i)
+            dm.insert(keys[i], static_cast<int>(i));
+        return dm.size();
+    };
+
+    DynamicMap dm;
+    FlatDynamicMap<> flat_dm;
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        dm.insert(keys[i], static_cast<int>(i));
+        flat_dm.insert(keys[i], static_cast<int>(i));
+    }
+
+    BENCHMARK("DynamicMap - get")
+    {
+        long sum{};
+        for (const auto& key : keys)
+            sum += dm.get<int>(key);
+        return sum;
+    };
+
+    BENCHMARK("FlatDynamicMap - get")
+    {
+        long sum{};
+        for (const auto& key : keys)
+            sum += flat_dm.get<int>(key);
+        return sum;
+    };
+
+    std::vector<FlatDynamicMap<>::Key<int>> typed_keys;
+    for (const auto& key : keys)
+        typed_keys.push_back(flat_dm.key<int>(key));
+
+    BENCHMARK("FlatDynamicMap - get with typed key")
+    {
+        long sum{};
+        for (const auto& key : typed_keys)
+            sum += flat_dm.get(key);
+        return sum;
+    };
+}
+
+TEST_CASE("FlatDynamicMap - insert_or_assign")
+{
+    FlatDynamicMap<> dm;
+    dm.insert_or_assign("timeout", 10);
+    dm.insert_or_assign("timeout", 20);
+
+    REQUIRE(dm.size() == 1);
+    REQUIRE(dm.get<int>("timeout") == 20);
+    REQUIRE_THROWS_AS(dm.insert_or_assign("timeout", "20"s), std::bad_any_cast);
+}
+
+TEST_CASE("ConcurrentDynamicMap - snapshots")
+{
+    ConcurrentDynamicMap<> config;
+    config.insert("timeout", 10);
+
+    auto old_snapshot = config.snapshot();
+    auto reader = config.reader();
+
+    config.update([](auto& map) {
+        map.insert_or_assign("timeout", 20);
+        map.insert("retries", 3);
+    });
+
+    REQUIRE(old_snapshot->get<int>("timeout") == 10); // snapshot is immutable
+    REQUIRE_FALSE(old_snapshot->contains("retries"));
+    REQUIRE(config.get<int>("timeout") == 20);
+    REQUIRE(reader.get<int>("retries") == 3);
+}
+
+TEST_CASE("ConcurrentDynamicMap - many readers & one writer")
+{
+    ConcurrentDynamicMap<> config;
+    config.update([](auto& map) {
+        map.insert("generation", 0);
+        map.insert("doubled", 0);
+    });
+
+    constexpr int updates = 2'000;
+    std::atomic<bool> done{false};
+    std::atomic<int> inconsistencies{0};
+    std::atomic<long> reads{0};
+    std::atomic<int> started_readers{0};
+
+    constexpr int reader_count = 8;
+    std::vector<std::thread> readers;
+    for (int i = 0; i < reader_count; ++i)
+    {
+        readers.emplace_back([&] {
+            auto reader = config.reader();
+            int last_generation = 0;
+
+            for (bool first_read = true; first_read || !done.load(); first_read = false)
+            {
+                const auto& map = reader.current();
+                const int generation = map.get<int>("generation");
+
+                // batch is published atomically - both values come from the same update
+                if (map.get<int>("doubled") != 2 * generation || generation < last_generation)
+                    ++inconsistencies;
+
+                last_generation = generation;
+                ++reads;
+
+                if (first_read)
+                    ++started_readers;
+            }
+        });
+    }
+
+    // updates start after every reader has read the map at least once
+    while (started_readers.load() < reader_count)
+        std::this_thread::yield();
+
+    for (int i = 1; i <= updates; ++i)
+    {
+        config.update([i](auto& map) {
+            map.insert_or_assign("generation", i);
+            map.insert_or_assign("doubled", 2 * i);
+        });
+    }
+
+    done = true;
+    for (auto& t : readers)
+        t.join();
+
+    REQUIRE(inconsistencies == 0);
+    REQUIRE(reads >= reader_count);
+    REQUIRE(config.get<int>("generation") == updates);
+}
+
+namespace
+{
+    class SharedMutexDynamicMap
+    {
+        FlatDynamicMap<> map_;
+        mutable std::shared_mutex mtx_;
+
+    public:
+        template <typename T>
+        T get(std::string_view key) const
+        {
+            std::shared_lock lk{mtx_};
+            return map_.get<T>(key);
+        }
+
+        template <typename T>
+        void insert_or_assign(std::string key, T value)
+        {
+            std::unique_lock lk{mtx_};
+            map_.insert_or_assign(std::move(key), std::move(value));
+        }
+    };
+
+    template <typename TReadAction>
+    void run_readers(unsigned int thread_count, int reads_per_thread, TReadAction read_action)
+    {
+        std::vector<std::thread> threads;
+        for (unsigned int i = 0; i < thread_count; ++i)
+        {
+            threads.emplace_back([=] {
+                auto read = read_action();
+                long sum{};
+                for (int j = 0; j < reads_per_thread; ++j)
+                    sum += read();
+                volatile long result = sum;
+                (void)result;
+            });
+        }
+
+        for (auto& t : threads)
+            t.join();
+    }
+}
+
+TEST_CASE("ConcurrentDynamicMap - benchmark", "[.benchmark]")
+{
+    constexpr int reads_per_thread = 100'000;
+    const unsigned int thread_count = std::max(2U, std::thread::hardware_concurrency());
+
+    ConcurrentDynamicMap<> rcu_map;
+    rcu_map.insert("timeout", 42);
+
+    SharedMutexDynamicMap locked_map;
+    locked_map.insert_or_assign("timeout", 42);
+
+    BENCHMARK("shared_mutex - " + std::to_string(thread_count) + " readers")
+    {
+        run_readers(thread_count, reads_per_thread, [&] {
+            return [&] { return locked_map.get<int>("timeout"); };
+        });
+    };
+
+    BENCHMARK("ConcurrentDynamicMap::Reader - " + std::to_string(thread_count) + " readers")
+    {
+        run_readers(thread_count, reads_per_thread, [&] {
+            return [reader = rcu_map.reader()]() mutable { return reader.get<int>("timeout"); };
+        });
+    };
+}
+
+TEST_CASE("DynamicMap - serialization")
+{
+    FlatDynamicMap<> dm;
+    dm.insert("pi", 3.14);
+    dm.insert("name", "config"s);
+    dm.insert("data", Data{1, 2});
+    dm.insert("timeout", 42);
+    dm.insert("empty", ""s);
+
+    const std::vector<char> buffer = serialize<int, double, std::string, Data>(dm);
+
+    SECTION("values are read in place")
+    {
+        DynamicMapView view{buffer};
+
+        REQUIRE(view.size() == 5);
+        REQUIRE(view.get<int>("timeout") == 42);
+        REQUIRE(view.get<double>("pi") == 3.14);
+        REQUIRE(view.get<std::string_view>("name") == "config");
+        REQUIRE(view.get<std::string>("empty").empty());
+        REQUIRE(view.get<Data>("data").b == 2);
+
+        const std::string_view name = view.get<std::string_view>("name");
+        REQUIRE(name.data() >= buffer.data());
+        REQUIRE(name.data() < buffer.data() + buffer.size());
+    }
+
+    SECTION("aligned buffer - pointers to values")
+    {
+        std::vector<uint64_t> aligned((buffer.size() + 7) / 8);
+        std::memcpy(aligned.data(), buffer.data(), buffer.size());
+
+        DynamicMapView view{reinterpret_cast<const char*>(aligned.data()), buffer.size()};
+
+        const Data* data = view.get_in_place<Data>("data");
+        REQUIRE(data != nullptr);
+        REQUIRE(data->a == 1);
+        REQUIRE(*view.get_in_place<double>("pi") == 3.14);
+    }
+
+    SECTION("round trip")
+    {
+        FlatDynamicMap<> loaded = deserialize<int, double, std::string, Data>(DynamicMapView{buffer});
+
+        REQUIRE(loaded.size() == dm.size());
+        REQUIRE(loaded.get<int>("timeout") == 42);
+        REQUIRE(loaded.get<double>("pi") == 3.14);
+        REQUIRE(loaded.get<std::string>("name") == "config");
+        REQUIRE(loaded.get<std::string>("empty") == "");
+        REQUIRE(loaded.get<Data>("data").a == 1);
+    }
+
+    SECTION("lookup errors")
+    {
+        DynamicMapView view{buffer};
+
+        REQUIRE_FALSE(view.contains("unknown"));
+        REQUIRE_THROWS_AS(view.get<int>("unknown"), std::out_of_range);
+        REQUIRE_THROWS_AS(view.get<int>("pi"), std::bad_any_cast);
+    }
+
+    SECTION("type not registered")
+    {
+        auto serialize_numbers = [&dm] { return serialize<int, double>(dm); };
+        REQUIRE_THROWS_AS(serialize_numbers(), std::invalid_argument);
+
+        auto deserialize_numbers = [&buffer] { return deserialize<int, double>(DynamicMapView{buffer}); };
+        REQUIRE_THROWS_AS(deserialize_numbers(), std::invalid_argument);
+    }
+
+    SECTION("corrupted buffer")
+    {
+        REQUIRE_THROWS_AS(DynamicMapView(buffer.data(), 8), std::runtime_error);
+
+        std::vector<char> truncated(buffer.begin(), buffer.end() - 1);
+        REQUIRE_THROWS_AS(DynamicMapView{truncated}, std::runtime_error);
+
+        std::vector<char> bad_magic = buffer;
+        bad_magic[0] = 'X';
+        REQUIRE_THROWS_AS(DynamicMapView{bad_magic}, std::runtime_error);
+    }
+
+    SECTION("corrupted entries")
+    {
+        using Serialization::EntryRecord;
+
+        // entries sorted by key: data, empty, name, pi, timeout
+        const size_t pi_record = sizeof(Serialization::Header) + 3 * sizeof(EntryRecord);
+        const size_t timeout_record = sizeof(Serialization::Header) + 4 * sizeof(EntryRecord);
+
+        std::vector<uint64_t> bad_size((buffer.size() + 7) / 8);
+        std::memcpy(bad_size.data(), buffer.data(), buffer.size());
+        char* bytes = reinterpret_cast<char*>(bad_size.data());
+        const uint32_t value_size = 4;
+        std::memcpy(bytes + pi_record + offsetof(EntryRecord, value_size), &value_size, sizeof(value_size));
+
+        DynamicMapView view{bytes, buffer.size()};
+        REQUIRE_THROWS_AS(view.get<double>("pi"), std::runtime_error);
+        REQUIRE_THROWS_AS(view.get_in_place<double>("pi"), std::runtime_error);
+
+        std::vector<char> duplicate_key = buffer;
+        std::memcpy(duplicate_key.data() + timeout_record, duplicate_key.data() + pi_record, sizeof(EntryRecord));
+
+        auto deserialize_duplicate = [&duplicate_key] { return deserialize<int, double, std::string, Data>(DynamicMapView{duplicate_key}); };
+        REQUIRE_THROWS_AS(deserialize_duplicate(), std::runtime_error); // not invalid_argument - the type is registered
+    }
+}
+
+TEST_CASE("DynamicMap - serialization benchmark", "[.benchmark]")
+{
+    const auto keys = make_keys(10'000);
+
+    FlatDynamicMap<> dm;
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        if (i % 3 == 0)
+            dm.insert(keys[i], static_cast<int>(i));
+        else if (i % 3 == 1)
+            dm.insert(keys[i], Data{static_cast<int>(i), 1});
+        else
+            dm.insert(keys[i], "value-" + std::to_string(i));
+    }
+
+    const std::vector<char> buffer = serialize<int, double, std::string, Data>(dm);
+
+    BENCHMARK("serialize")
+    {
+        return serialize<int, double, std::string, Data>(dm);
+    };
+
+    BENCHMARK("load - naive per-entry decode + get")
+    {
+        FlatDynamicMap<> loaded = deserialize<int, double, std::string, Data>(DynamicMapView{buffer});
+        return loaded.get<int>(keys[0]);
+    };
+
+    BENCHMARK("load - in place view + get")
+    {
+        DynamicMapView view{buffer};
+        return view.get<int>(keys[0]);
+    };
+}
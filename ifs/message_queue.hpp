@@ -0,0 +1,205 @@
+#ifndef MESSAGE_QUEUE_HPP
+#define MESSAGE_QUEUE_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// message storage policies for MessageQueue - not synchronized, the queue holds the lock
+
+// every message is a std::string moved in and out of the queue
+class StringStorage
+{
+    std::queue<std::string> q_msg_;
+
+public:
+    template <typename TMessage>
+    void push(TMessage&& msg)
+    {
+        q_msg_.emplace(std::forward<TMessage>(msg));
+    }
+
+    void pop_into(std::string& msg)
+    {
+        msg = std::move(q_msg_.front());
+        q_msg_.pop();
+    }
+
+    size_t size() const noexcept
+    {
+        return q_msg_.size();
+    }
+};
+
+// payloads are copied into a per-queue ring of bytes ([length][characters] records),
+// popped into strings supplied by the consumer - once the ring has grown to the working set
+// and consumers reuse their strings, no message touches the global allocator
+class ArenaStorage
+{
+    using Length = uint32_t;
+
+    std::vector<char> buffer_;
+    size_t head_{};
+    size_t used_{};
+    size_t count_{};
+
+    size_t mask() const noexcept
+    {
+        return buffer_.size() - 1;
+    }
+
+    // bytes may wrap around the end of the ring
+    void write(const void* data, size_t size) noexcept
+    {
+        const size_t pos = (head_ + used_) & mask();
+        const size_t first_part = std::min(size, buffer_.size() - pos);
+
+        std::memcpy(buffer_.data() + pos, data, first_part);
+        std::memcpy(buffer_.data(), static_cast<const char*>(data) + first_part, size - first_part);
+        used_ += size;
+    }
+
+    void read(void* data, size_t size) noexcept
+    {
+        const size_t first_part = std::min(size, buffer_.size() - head_);
+
+        std::memcpy(data, buffer_.data() + head_, first_part);
+        std::memcpy(static_cast<char*>(data) + first_part, buffer_.data(), size - first_part);
+        head_ = (head_ + size) & mask();
+        used_ -= size;
+    }
+
+    void reserve(size_t size)
+    {
+        if (used_ + size <= buffer_.size())
+            return;
+
+        size_t new_capacity = buffer_.size();
+        while (new_capacity < used_ + size)
+            new_capacity *= 2;
+
+        std::vector<char> new_buffer(new_capacity);
+        const size_t used = used_;
+        read(new_buffer.data(), used);
+
+        buffer_.swap(new_buffer);
+        head_ = 0;
+        used_ = used;
+    }
+
+public:
+    // capacity is rounded up to a power of two
+    explicit ArenaStorage(size_t initial_capacity = 4096)
+    {
+        size_t capacity = 64;
+        while (capacity < initial_capacity)
+            capacity *= 2;
+
+        buffer_.resize(capacity);
+    }
+
+    void push(std::string_view msg)
+    {
+        assert(msg.size() <= std::numeric_limits<Length>::max());
+
+        const auto length = static_cast<Length>(msg.size());
+        reserve(sizeof(length) + length);
+        write(&length, sizeof(length));
+        write(msg.data(), length);
+        ++count_;
+    }
+
+    void pop_into(std::string& msg)
+    {
+        Length length;
+        read(&length, sizeof(length));
+
+        msg.resize(length);
+        read(msg.data(), length);
+        --count_;
+    }
+
+    size_t size() const noexcept
+    {
+        return count_;
+    }
+
+    size_t capacity() const noexcept
+    {
+        return buffer_.size();
+    }
+};
+
+// the q_msg pattern with batching - one lock per batch, messages are moved (or copied from
+// the arena into reused strings) instead of copying q_msg.front() before pop()
+template <typename TStorage = StringStorage>
+class MessageQueue
+{
+    TStorage storage_;
+    mutable std::mutex mtx_;
+
+public:
+    MessageQueue() = default;
+
+    explicit MessageQueue(TStorage storage)
+        : storage_{std::move(storage)}
+    {
+    }
+
+    template <typename TMessage>
+    void push(TMessage&& msg)
+    {
+        std::lock_guard lk{mtx_};
+        storage_.push(std::forward<TMessage>(msg));
+    }
+
+    // pass move iterators to move messages into the queue
+    template <typename TIterator>
+    void push_bulk(TIterator first, TIterator last)
+    {
+        std::lock_guard lk{mtx_};
+        for (; first != last; ++first)
+            storage_.push(*first);
+    }
+
+    bool try_pop(std::string& msg)
+    {
+        if (std::lock_guard lk{mtx_}; storage_.size() != 0)
+        {
+            storage_.pop_into(msg);
+            return true;
+        }
+
+        return false;
+    }
+
+    // out - iterator to at least max_count existing strings (e.g. a reused std::vector<std::string>);
+    // returns number of popped messages
+    template <typename TIterator>
+    size_t pop_bulk(TIterator out, size_t max_count)
+    {
+        std::lock_guard lk{mtx_};
+
+        const size_t count = std::min(max_count, storage_.size());
+        for (size_t i = 0; i < count; ++i, ++out)
+            storage_.pop_into(*out);
+
+        return count;
+    }
+
+    size_t size() const
+    {
+        std::lock_guard lk{mtx_};
+        return storage_.size();
+    }
+};
+
+#endif
@@ -0,0 +1,326 @@
+#ifndef MPMC_QUEUE_HPP
+#define MPMC_QUEUE_HPP
+
+#include <atomic>
+#include <cassert>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+constexpr size_t cache_line_size = 64;
+
+// bounded lock-free multi-producer multi-consumer queue (D. Vyukov's design):
+// every cell has a sequence number telling whether it is ready for the producer or the consumer
+// of the current lap, so producers and consumers only contend on their own position counter
+template <typename T>
+class MpmcQueue
+{
+    // once a cell is claimed, its item must be constructed/moved out without exceptions -
+    // otherwise the cell is never published and every later lap over it hangs
+    static_assert(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>,
+        "MpmcQueue requires nothrow move of items");
+
+    struct alignas(cache_line_size) Cell
+    {
+        std::atomic<size_t> sequence;
+        std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+
+        T* value() noexcept
+        {
+            return std::launder(reinterpret_cast<T*>(&storage));
+        }
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_;
+    alignas(cache_line_size) std::atomic<size_t> enqueue_pos_{0};
+    alignas(cache_line_size) std::atomic<size_t> dequeue_pos_{0};
+
+    static size_t round_up_to_power_of_2(size_t capacity) noexcept
+    {
+        size_t result = 2;
+        while (result < capacity)
+            result *= 2;
+        return result;
+    }
+
+    // claims a cell and constructs the item in it
+    template <typename TValue>
+    bool try_push_nothrow(TValue&& value) noexcept
+    {
+        Cell* cell;
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            cell = &cells_[pos & mask_];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+
+            if (diff == 0)
+            {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                return false; // full - the cell still holds an item from the previous lap
+            }
+            else
+            {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        ::new (static_cast<void*>(&cell->storage)) T(std::forward<TValue>(value));
+        cell->sequence.store(pos + 1, std::memory_order_release);
+
+        return true;
+    }
+
+public:
+    using value_type = T;
+
+    // capacity is rounded up to a power of two
+    explicit MpmcQueue(size_t capacity)
+        : cells_{new Cell[round_up_to_power_of_2(capacity)]}
+        , mask_{round_up_to_power_of_2(capacity) - 1}
+    {
+        for (size_t i = 0; i <= mask_; ++i)
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    ~MpmcQueue()
+    {
+        const size_t end = enqueue_pos_.load(std::memory_order_relaxed);
+        for (size_t pos = dequeue_pos_.load(std::memory_order_relaxed); pos != end; ++pos)
+            cells_[pos & mask_].value()->~T();
+    }
+
+    size_t capacity() const noexcept
+    {
+        return mask_ + 1;
+    }
+
+    // a conversion that may throw (e.g. std::string from const char*) is done before a cell is claimed
+    template <typename TValue>
+    bool try_push(TValue&& value)
+    {
+        if constexpr (!std::is_nothrow_constructible_v<T, TValue&&>)
+            return try_push(T(std::forward<TValue>(value)));
+        else
+            return try_push_nothrow(std::forward<TValue>(value));
+    }
+
+    bool try_pop(T& value) noexcept
+    {
+        Cell* cell;
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            cell = &cells_[pos & mask_];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+
+            if (diff == 0)
+            {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                return false; // empty
+            }
+            else
+            {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        T* item = cell->value();
+        value = std::move(*item);
+        item->~T();
+        cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+
+        return true;
+    }
+};
+
+// lets threads sleep until a condition may have changed - waiting is a futex on Linux,
+// elsewhere the waiter just yields; notify is a fence and a load when nobody waits
+class EventCount
+{
+    std::atomic<uint32_t> epoch_{0};
+    std::atomic<uint32_t> waiters_{0};
+
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) && std::atomic<uint32_t>::is_always_lock_free);
+
+public:
+    // call before re-checking the condition
+    uint32_t prepare_wait() noexcept
+    {
+        waiters_.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return epoch_.load(std::memory_order_acquire);
+    }
+
+    void cancel_wait() noexcept
+    {
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // sleeps unless notify was called after prepare_wait
+    void wait(uint32_t epoch) noexcept
+    {
+#ifdef __linux__
+        ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&epoch_), FUTEX_WAIT_PRIVATE, epoch, nullptr, nullptr, 0);
+#else
+        if (epoch_.load(std::memory_order_acquire) == epoch)
+            std::this_thread::yield();
+#endif
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // call after the condition was changed - every waiter that is not asleep yet sees the new epoch,
+    // so waking one sleeper per change is enough
+    void notify_one() noexcept
+    {
+        notify(1);
+    }
+
+    void notify_all() noexcept
+    {
+        notify(INT_MAX);
+    }
+
+private:
+    void notify([[maybe_unused]] int count) noexcept
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (waiters_.load(std::memory_order_relaxed) == 0)
+            return;
+
+        epoch_.fetch_add(1, std::memory_order_release);
+#ifdef __linux__
+        ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&epoch_), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+#endif
+    }
+};
+
+// MpmcQueue with blocking push/pop - threads spin for a while, then sleep on a futex
+// when the queue is full/empty
+template <typename T>
+class BlockingMpmcQueue
+{
+    static constexpr int spin_count = 64;
+
+    MpmcQueue<T> queue_;
+    EventCount not_empty_;
+    EventCount not_full_;
+
+public:
+    using value_type = T;
+
+    explicit BlockingMpmcQueue(size_t capacity)
+        : queue_{capacity}
+    {
+    }
+
+    size_t capacity() const noexcept
+    {
+        return queue_.capacity();
+    }
+
+    template <typename TValue>
+    bool try_push(TValue&& value)
+    {
+        if (!queue_.try_push(std::forward<TValue>(value)))
+            return false;
+
+        not_empty_.notify_one();
+        return true;
+    }
+
+    bool try_pop(T& value)
+    {
+        if (!queue_.try_pop(value))
+            return false;
+
+        not_full_.notify_one();
+        return true;
+    }
+
+    // value is moved from only when it is stored in the queue
+    template <typename TValue>
+    void push(TValue&& value)
+    {
+        if constexpr (!std::is_nothrow_constructible_v<T, TValue&&>)
+        {
+            push(T(std::forward<TValue>(value))); // convert once, not on every attempt
+            return;
+        }
+
+        for (int i = 0; i < spin_count; ++i)
+        {
+            if (try_push(std::forward<TValue>(value)))
+                return;
+
+            std::this_thread::yield();
+        }
+
+        while (!try_push(std::forward<TValue>(value)))
+        {
+            const uint32_t epoch = not_full_.prepare_wait();
+
+            if (try_push(std::forward<TValue>(value)))
+            {
+                not_full_.cancel_wait();
+                return;
+            }
+
+            not_full_.wait(epoch);
+        }
+    }
+
+    void pop(T& value)
+    {
+        for (int i = 0; i < spin_count; ++i)
+        {
+            if (try_pop(value))
+                return;
+
+            std::this_thread::yield();
+        }
+
+        while (!try_pop(value))
+        {
+            const uint32_t epoch = not_empty_.prepare_wait();
+
+            if (try_pop(value))
+            {
+                not_empty_.cancel_wait();
+                return;
+            }
+
+            not_empty_.wait(epoch);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,224 @@
+#ifndef POWER_OF_2_HPP
+#define POWER_OF_2_HPP
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define POWER_OF_2_AVX2 1
+#include <immintrin.h>
+#endif
+
+// batch is_power_of_2 for arrays of 32/64-bit integers and IEEE floats - result is a bitmask
+// (bit i % 64 of word i / 64 is set when values[i] is a power of two);
+// floats are classified by their bits instead of frexp: a positive finite value is a power of two
+// when its mantissa bits are zero (normal numbers) or the whole representation has exactly one bit set (denormals);
+// AVX2 path selected at runtime, scalar fallback elsewhere
+namespace PowerOf2
+{
+    template <typename T>
+    constexpr bool is_supported_v = (std::is_integral_v<T> && !std::is_same_v<T, bool> && (sizeof(T) == 4 || sizeof(T) == 8))
+        || (std::is_floating_point_v<T> && std::numeric_limits<T>::is_iec559 && (sizeof(T) == 4 || sizeof(T) == 8));
+
+    // layout of IEEE float/double seen as a signed integer
+    template <typename T>
+    struct FloatBits;
+
+    template <>
+    struct FloatBits<float>
+    {
+        using Int = int32_t;
+        static constexpr Int mantissa_mask = 0x007F'FFFF;
+        static constexpr Int infinity = 0x7F80'0000;
+        static constexpr Int min_normal = 0x0080'0000;
+    };
+
+    template <>
+    struct FloatBits<double>
+    {
+        using Int = int64_t;
+        static constexpr Int mantissa_mask = 0x000F'FFFF'FFFF'FFFF;
+        static constexpr Int infinity = 0x7FF0'0000'0000'0000;
+        static constexpr Int min_normal = 0x0010'0000'0000'0000;
+    };
+
+    inline size_t mask_words(size_t size) noexcept
+    {
+        return (size + 63) / 64;
+    }
+
+    inline bool is_set(const uint64_t* mask, size_t index) noexcept
+    {
+        return (mask[index / 64] >> (index % 64)) & 1;
+    }
+
+    namespace Scalar
+    {
+        inline int popcount(uint64_t bits) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_popcountll(bits);
+#else
+            return static_cast<int>(std::bitset<64>(bits).count());
+#endif
+        }
+
+        template <typename T>
+        bool is_power_of_2(T value) noexcept
+        {
+            if constexpr (std::is_integral_v<T>)
+            {
+                return (value > 0) & (popcount(static_cast<std::make_unsigned_t<T>>(value)) == 1);
+            }
+            else
+            {
+                using Bits = FloatBits<T>;
+
+                typename Bits::Int bits;
+                std::memcpy(&bits, &value, sizeof(value));
+
+                // negative values, zeros, inf and NaN fail the range checks;
+                // no short-circuit - branches on random data are mispredicted
+                const bool normal = ((bits & Bits::mantissa_mask) == 0) & (bits < Bits::infinity);
+                const bool denormal = (bits < Bits::min_normal) & (popcount(static_cast<uint64_t>(bits)) == 1);
+                return (bits > 0) & (normal | denormal);
+            }
+        }
+
+        template <typename T>
+        void classify(const T* values, size_t size, uint64_t* mask) noexcept
+        {
+            for (size_t i = 0; i < size; i += 64)
+            {
+                const size_t count = std::min<size_t>(64, size - i);
+
+                uint64_t word{};
+                for (size_t j = 0; j < count; ++j)
+                    word |= uint64_t{is_power_of_2(values[i + j])} << j;
+
+                mask[i / 64] = word;
+            }
+        }
+    }
+
+#ifdef POWER_OF_2_AVX2
+    namespace Avx2
+    {
+        // one bit per lane of a 32-byte block - 8 values of 32 bits or 4 values of 64 bits
+        template <typename T>
+        __attribute__((target("avx2"))) inline uint32_t block_bits(const T* values) noexcept
+        {
+            const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+            const __m256i zero = _mm256_setzero_si256();
+
+            if constexpr (sizeof(T) == 4)
+            {
+                const __m256i single_bit = _mm256_cmpeq_epi32(_mm256_and_si256(block, _mm256_sub_epi32(block, _mm256_set1_epi32(1))), zero);
+                __m256i result;
+
+                if constexpr (std::is_integral_v<T>)
+                {
+                    const __m256i positive = std::is_signed_v<T> ? _mm256_cmpgt_epi32(block, zero) : _mm256_xor_si256(_mm256_cmpeq_epi32(block, zero), _mm256_set1_epi32(-1));
+                    result = _mm256_and_si256(positive, single_bit);
+                }
+                else
+                {
+                    using Bits = FloatBits<T>;
+
+                    const __m256i positive = _mm256_cmpgt_epi32(block, zero);
+                    const __m256i no_mantissa = _mm256_cmpeq_epi32(_mm256_and_si256(block, _mm256_set1_epi32(Bits::mantissa_mask)), zero);
+                    const __m256i finite = _mm256_cmpgt_epi32(_mm256_set1_epi32(Bits::infinity), block);
+                    const __m256i denormal = _mm256_cmpgt_epi32(_mm256_set1_epi32(Bits::min_normal), block);
+
+                    result = _mm256_and_si256(positive, _mm256_or_si256(_mm256_and_si256(no_mantissa, finite), _mm256_and_si256(denormal, single_bit)));
+                }
+
+                return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(result)));
+            }
+            else
+            {
+                const __m256i single_bit = _mm256_cmpeq_epi64(_mm256_and_si256(block, _mm256_sub_epi64(block, _mm256_set1_epi64x(1))), zero);
+                __m256i result;
+
+                if constexpr (std::is_integral_v<T>)
+                {
+                    const __m256i positive = std::is_signed_v<T> ? _mm256_cmpgt_epi64(block, zero) : _mm256_xor_si256(_mm256_cmpeq_epi64(block, zero), _mm256_set1_epi64x(-1));
+                    result = _mm256_and_si256(positive, single_bit);
+                }
+                else
+                {
+                    using Bits = FloatBits<T>;
+
+                    const __m256i positive = _mm256_cmpgt_epi64(block, zero);
+                    const __m256i no_mantissa = _mm256_cmpeq_epi64(_mm256_and_si256(block, _mm256_set1_epi64x(Bits::mantissa_mask)), zero);
+                    const __m256i finite = _mm256_cmpgt_epi64(_mm256_set1_epi64x(Bits::infinity), block);
+                    const __m256i denormal = _mm256_cmpgt_epi64(_mm256_set1_epi64x(Bits::min_normal), block);
+
+                    result = _mm256_and_si256(positive, _mm256_or_si256(_mm256_and_si256(no_mantissa, finite), _mm256_and_si256(denormal, single_bit)));
+                }
+
+                return static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(result)));
+            }
+        }
+
+        template <typename T>
+        __attribute__((target("avx2"))) inline void classify(const T* values, size_t size, uint64_t* mask) noexcept
+        {
+            constexpr size_t lanes = 32 / sizeof(T);
+
+            size_t i = 0;
+            for (; i + 64 <= size; i += 64)
+            {
+                uint64_t word{};
+                for (size_t j = 0; j < 64; j += lanes)
+                    word |= uint64_t{block_bits(values + i + j)} << j;
+
+                mask[i / 64] = word;
+            }
+
+            Scalar::classify(values + i, size - i, mask + i / 64);
+        }
+    }
+#endif
+
+    inline bool has_avx2() noexcept
+    {
+#if defined(__AVX2__)
+        return true;
+#elif defined(POWER_OF_2_AVX2)
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+    // mask - at least mask_words(size) words
+    template <typename T>
+    void classify(const T* values, size_t size, uint64_t* mask) noexcept
+    {
+        static_assert(is_supported_v<T>, "32/64-bit integers or IEEE floats required");
+
+#ifdef POWER_OF_2_AVX2
+        if (has_avx2())
+            return Avx2::classify(values, size, mask);
+#endif
+        Scalar::classify(values, size, mask);
+    }
+
+    template <typename T>
+    std::vector<uint64_t> classify(const std::vector<T>& values)
+    {
+        std::vector<uint64_t> mask(mask_words(values.size()));
+        classify(values.data(), values.size(), mask.data());
+        return mask;
+    }
+}
+
+#endif
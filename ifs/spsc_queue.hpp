@@ -0,0 +1,183 @@
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include "mpmc_queue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// bounded wait-free single-producer single-consumer ring:
+// - producer owns tail_, consumer owns head_ - each index lives on its own cache line
+//   together with the owner's cached copy of the other index
+// - the other side's index is re-read only when the cached copy says full/empty,
+//   so in steady state push/pop touch no shared cache line except the item itself
+// - bulk operations publish the whole batch with a single store
+template <typename T>
+class SpscQueue
+{
+    using Storage = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+    std::unique_ptr<Storage[]> items_;
+    size_t mask_;
+
+    // consumer's cache line
+    alignas(cache_line_size) std::atomic<size_t> head_{0};
+    size_t cached_tail_{0};
+
+    // producer's cache line
+    alignas(cache_line_size) std::atomic<size_t> tail_{0};
+    size_t cached_head_{0};
+
+    static size_t round_up_to_power_of_2(size_t capacity) noexcept
+    {
+        size_t result = 2;
+        while (result < capacity)
+            result *= 2;
+        return result;
+    }
+
+    T* item(size_t pos) noexcept
+    {
+        return std::launder(reinterpret_cast<T*>(&items_[pos & mask_]));
+    }
+
+    // producer side - number of free slots, refreshes cached head only when needed
+    size_t free_slots(size_t tail, size_t wanted) noexcept
+    {
+        size_t free = capacity() - (tail - cached_head_);
+
+        if (free < wanted)
+        {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            free = capacity() - (tail - cached_head_);
+        }
+
+        return free;
+    }
+
+    // consumer side - number of ready items, refreshes cached tail only when needed
+    size_t ready_items(size_t head, size_t wanted) noexcept
+    {
+        size_t ready = cached_tail_ - head;
+
+        if (ready < wanted)
+        {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            ready = cached_tail_ - head;
+        }
+
+        return ready;
+    }
+
+public:
+    using value_type = T;
+
+    // capacity is rounded up to a power of two
+    explicit SpscQueue(size_t capacity)
+        : items_{new Storage[round_up_to_power_of_2(capacity)]}
+        , mask_{round_up_to_power_of_2(capacity) - 1}
+    {
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    ~SpscQueue()
+    {
+        const size_t end = tail_.load(std::memory_order_relaxed);
+        for (size_t pos = head_.load(std::memory_order_relaxed); pos != end; ++pos)
+            item(pos)->~T();
+    }
+
+    size_t capacity() const noexcept
+    {
+        return mask_ + 1;
+    }
+
+    // producer only
+    template <typename TValue>
+    bool try_push(TValue&& value)
+    {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+
+        if (free_slots(tail, 1) == 0)
+            return false;
+
+        ::new (static_cast<void*>(&items_[tail & mask_])) T(std::forward<TValue>(value));
+        tail_.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    // producer only - pushes as many items as fit, returns iterator to the first item not pushed;
+    // pass move iterators to move items into the queue;
+    // if a constructor throws, nothing from the batch is pushed
+    template <typename TIterator>
+    TIterator try_push_bulk(TIterator first, TIterator last)
+    {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t free = free_slots(tail, static_cast<size_t>(std::distance(first, last)));
+
+        size_t count = 0;
+        try
+        {
+            for (; first != last && count < free; ++first, ++count)
+                ::new (static_cast<void*>(&items_[(tail + count) & mask_])) T(*first);
+        }
+        catch (...)
+        {
+            for (size_t i = 0; i < count; ++i)
+                item(tail + i)->~T();
+            throw;
+        }
+
+        if (count != 0)
+            tail_.store(tail + count, std::memory_order_release);
+
+        return first;
+    }
+
+    // consumer only
+    bool try_pop(T& value)
+    {
+        const size_t head = head_.load(std::memory_order_relaxed);
+
+        if (ready_items(head, 1) == 0)
+            return false;
+
+        T* ready = item(head);
+        value = std::move(*ready);
+        ready->~T();
+        head_.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    // consumer only - out - iterator to at least max_count existing items;
+    // returns number of popped items
+    template <typename TIterator>
+    size_t try_pop_bulk(TIterator out, size_t max_count)
+    {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        const size_t count = std::min(max_count, ready_items(head, max_count));
+
+        for (size_t i = 0; i < count; ++i, ++out)
+        {
+            T* ready = item(head + i);
+            *out = std::move(*ready);
+            ready->~T();
+        }
+
+        if (count != 0)
+            head_.store(head + count, std::memory_order_release);
+
+        return count;
+    }
+};
+
+#endif
@@ -1,11 +1,19 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "power_of_2.hpp"
+
 #include <algorithm>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <mutex>
 #include <numeric>
 #include <queue>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -122,6 +130,184 @@ TEST_CASE("constexpr if")
     REQUIRE(is_power_of_2(8.0));
 }
 
+namespace
+{
+    // bit patterns of every power of two (with neighbours) plus random bits and special values
+    template <typename T>
+    std::vector<T> power_of_2_test_values(size_t random_count)
+    {
+        std::vector<T> values;
+
+        if constexpr (std::is_integral_v<T>)
+        {
+            for (int exponent = 0; exponent < std::numeric_limits<T>::digits; ++exponent)
+            {
+                const T power = T{1} << exponent;
+                values.insert(values.end(), {power, T(power - 1), T(power + 1), T(-power)});
+            }
+
+            values.insert(values.end(), {T{0}, std::numeric_limits<T>::min(), std::numeric_limits<T>::max()});
+        }
+        else
+        {
+            using Limits = std::numeric_limits<T>;
+
+            for (int exponent = Limits::min_exponent - Limits::digits; exponent < Limits::max_exponent; ++exponent)
+            {
+                const T power = std::ldexp(T{1}, exponent);
+                values.insert(values.end(), {power, -power, std::nextafter(power, T{0}), std::nextafter(power, Limits::infinity())});
+            }
+
+            values.insert(values.end(), {T{0}, -T{0}, Limits::infinity(), -Limits::infinity(), Limits::quiet_NaN(),
+                                            -Limits::quiet_NaN(), Limits::signaling_NaN(), Limits::denorm_min(), Limits::min(), Limits::max(), Limits::lowest()});
+        }
+
+        using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+        std::mt19937_64 rnd{665};
+        for (size_t i = 0; i < random_count; ++i)
+        {
+            const auto bits = static_cast<Bits>(rnd());
+            T value;
+            std::memcpy(&value, &bits, sizeof(value));
+            values.push_back(value);
+        }
+
+        return values;
+    }
+
+    // the scalar template is the reference implementation
+    template <typename T>
+    int count_mismatches(const std::vector<T>& values, const std::vector<uint64_t>& mask)
+    {
+        int mismatches = 0;
+        for (size_t i = 0; i < values.size(); ++i)
+            mismatches += PowerOf2::is_set(mask.data(), i) != is_power_of_2(values[i]);
+
+        return mismatches;
+    }
+
+    template <typename T>
+    void check_batch_classifier()
+    {
+        const auto values = power_of_2_test_values<T>(10'000);
+
+        std::vector<uint64_t> scalar_mask(PowerOf2::mask_words(values.size()));
+        PowerOf2::Scalar::classify(values.data(), values.size(), scalar_mask.data());
+        REQUIRE(count_mismatches(values, scalar_mask) == 0);
+
+        REQUIRE(PowerOf2::classify(values) == scalar_mask);
+
+        // sizes not multiple of SIMD width - bits past the end stay zero
+        for (size_t size : {0, 1, 3, 7, 63, 64, 65, 131})
+        {
+            std::vector<uint64_t> mask(PowerOf2::mask_words(size) + 1, ~uint64_t{});
+            PowerOf2::classify(values.data(), size, mask.data());
+
+            REQUIRE(count_mismatches(std::vector<T>(values.begin(), values.begin() + size), mask) == 0);
+            if (size % 64 != 0)
+                REQUIRE(mask[size / 64] >> (size % 64) == 0);
+            REQUIRE(mask.back() == ~uint64_t{});
+        }
+    }
+}
+
+TEST_CASE("constexpr if - batch classifier")
+{
+    SECTION("integers")
+    {
+        check_batch_classifier<int32_t>();
+        check_batch_classifier<int64_t>();
+        check_batch_classifier<uint32_t>();
+        check_batch_classifier<uint64_t>();
+    }
+
+    SECTION("floats")
+    {
+        check_batch_classifier<float>();
+        check_batch_classifier<double>();
+    }
+
+    SECTION("special values")
+    {
+        using Limits = std::numeric_limits<double>;
+        const std::vector<double> values = {
+            Limits::denorm_min(), 3 * Limits::denorm_min(), Limits::min(), Limits::min() / 4, Limits::min() / 3,
+            0.0, -0.0, Limits::infinity(), -Limits::infinity(), Limits::quiet_NaN(), 0.5, -0.5, 1.0, 3.0, 0x1p1023, Limits::max()};
+
+        const auto mask = PowerOf2::classify(values);
+        REQUIRE(mask.size() == 1);
+        REQUIRE(mask[0] == 0b0101'0100'0000'1101);
+    }
+}
+
+TEST_CASE("constexpr if - batch classifier benchmark", "[.benchmark]")
+{
+    constexpr size_t size = 1'000'000;
+
+    auto scalar_template = [](const auto& values, std::vector<uint64_t>& mask) {
+        std::fill(mask.begin(), mask.end(), 0);
+        for (size_t i = 0; i < values.size(); ++i)
+            mask[i / 64] |= uint64_t{is_power_of_2(values[i])} << (i % 64);
+        return mask[0];
+    };
+
+    const auto ints = power_of_2_test_values<int32_t>(size);
+    const auto floats = power_of_2_test_values<float>(size);
+    const auto doubles = power_of_2_test_values<double>(size);
+    std::vector<uint64_t> mask(PowerOf2::mask_words(std::max({ints.size(), floats.size(), doubles.size()})));
+
+    BENCHMARK("int - is_power_of_2<T>")
+    {
+        return scalar_template(ints, mask);
+    };
+
+    BENCHMARK("int - PowerOf2::Scalar::classify")
+    {
+        PowerOf2::Scalar::classify(ints.data(), ints.size(), mask.data());
+        return mask[0];
+    };
+
+    BENCHMARK("int - PowerOf2::classify")
+    {
+        PowerOf2::classify(ints.data(), ints.size(), mask.data());
+        return mask[0];
+    };
+
+    BENCHMARK("float - is_power_of_2<T> (frexp)")
+    {
+        return scalar_template(floats, mask);
+    };
+
+    BENCHMARK("float - PowerOf2::Scalar::classify")
+    {
+        PowerOf2::Scalar::classify(floats.data(), floats.size(), mask.data());
+        return mask[0];
+    };
+
+    BENCHMARK("float - PowerOf2::classify")
+    {
+        PowerOf2::classify(floats.data(), floats.size(), mask.data());
+        return mask[0];
+    };
+
+    BENCHMARK("double - is_power_of_2<T> (frexp)")
+    {
+        return scalar_template(doubles, mask);
+    };
+
+    BENCHMARK("double - PowerOf2::Scalar::classify")
+    {
+        PowerOf2::Scalar::classify(doubles.data(), doubles.size(), mask.data());
+        return mask[0];
+    };
+
+    BENCHMARK("double - PowerOf2::classify")
+    {
+        PowerOf2::classify(doubles.data(), doubles.size(), mask.data());
+        return mask[0];
+    };
+}
+
 namespace [[deprecated]] BeforeCpp17
 {
     void print()
@@ -0,0 +1,867 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "message_queue.hpp"
+#include "mpmc_queue.hpp"
+#include "spsc_queue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <queue>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+    // the q_msg pattern from "if with mutex" behind the try_push/try_pop interface
+    template <typename T>
+    class MutexQueue
+    {
+        std::queue<T> q_msg_;
+        std::mutex mtx_q_msg_;
+
+    public:
+        template <typename TValue>
+        bool try_push(TValue&& value)
+        {
+            std::lock_guard lk{mtx_q_msg_};
+            q_msg_.push(std::forward<TValue>(value));
+            return true;
+        }
+
+        bool try_pop(T& value)
+        {
+            if (std::lock_guard lk{mtx_q_msg_}; !std::empty(q_msg_))
+            {
+                value = q_msg_.front();
+                q_msg_.pop();
+                return true;
+            }
+
+            return false;
+        }
+    };
+
+    // every producer pushes values 1..count_per_producer, consumers pop until all values arrive;
+    // returns the sum of popped values
+    template <typename TQueue>
+    long long exchange(TQueue& queue, unsigned int producers, unsigned int consumers, int count_per_producer)
+    {
+        const long long total = static_cast<long long>(producers) * count_per_producer;
+        std::atomic<long long> popped{0};
+        std::atomic<long long> sum{0};
+
+        std::vector<std::thread> threads;
+
+        for (unsigned int i = 0; i < producers; ++i)
+        {
+            threads.emplace_back([&queue, count_per_producer] {
+                for (int value = 1; value <= count_per_producer; ++value)
+                {
+                    while (!queue.try_push(value))
+                        std::this_thread::yield();
+                }
+            });
+        }
+
+        for (unsigned int i = 0; i < consumers; ++i)
+        {
+            threads.emplace_back([&] {
+                long long local_sum{};
+                int value;
+
+                while (popped.load(std::memory_order_relaxed) < total)
+                {
+                    if (queue.try_pop(value))
+                    {
+                        local_sum += value;
+                        popped.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    else
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+
+                sum += local_sum;
+            });
+        }
+
+        for (auto& t : threads)
+            t.join();
+
+        return sum;
+    }
+
+    long long expected_sum(unsigned int producers, int count_per_producer)
+    {
+        return static_cast<long long>(producers) * count_per_producer * (count_per_producer + 1) / 2;
+    }
+}
+
+TEST_CASE("MpmcQueue")
+{
+    MpmcQueue<std::string> queue{5};
+    REQUIRE(queue.capacity() == 8);
+
+    SECTION("FIFO")
+    {
+        REQUIRE(queue.try_push("one"));
+        REQUIRE(queue.try_push(std::string{"two"}));
+
+        std::string msg;
+        REQUIRE(queue.try_pop(msg));
+        REQUIRE(msg == "one");
+        REQUIRE(queue.try_pop(msg));
+        REQUIRE(msg == "two");
+        REQUIRE_FALSE(queue.try_pop(msg));
+    }
+
+    SECTION("full queue rejects push")
+    {
+        for (int i = 0; i < 8; ++i)
+            REQUIRE(queue.try_push(std::to_string(i)));
+
+        std::string rejected = "rejected";
+        REQUIRE_FALSE(queue.try_push(std::move(rejected)));
+        REQUIRE(rejected == "rejected"); // not moved from
+
+        std::string msg;
+        REQUIRE(queue.try_pop(msg));
+        REQUIRE(msg == "0");
+        REQUIRE(queue.try_push("8"));
+    }
+
+    SECTION("wraps around many laps")
+    {
+        std::string msg;
+        for (int i = 0; i < 100; ++i)
+        {
+            REQUIRE(queue.try_push(std::to_string(i)));
+            REQUIRE(queue.try_pop(msg));
+            REQUIRE(msg == std::to_string(i));
+        }
+    }
+}
+
+TEST_CASE("MpmcQueue - move-only items left in queue are destroyed")
+{
+    auto counter = std::make_shared<int>(0);
+    {
+        MpmcQueue<std::shared_ptr<int>> queue{4};
+        queue.try_push(counter);
+        queue.try_push(counter);
+
+        std::shared_ptr<int> item;
+        queue.try_pop(item);
+        REQUIRE(counter.use_count() == 3);
+    }
+    REQUIRE(counter.use_count() == 1);
+
+    MpmcQueue<std::unique_ptr<int>> queue{2};
+    REQUIRE(queue.try_push(std::make_unique<int>(42)));
+
+    std::unique_ptr<int> ptr;
+    REQUIRE(queue.try_pop(ptr));
+    REQUIRE(*ptr == 42);
+}
+
+namespace
+{
+    // copy constructor throws on the given copy, move never throws; counts live objects
+    struct ThrowingCopy
+    {
+        inline static int live = 0;
+        inline static int copies_until_throw = -1;
+
+        ThrowingCopy()
+        {
+            ++live;
+        }
+
+        ThrowingCopy(const ThrowingCopy&)
+        {
+            if (copies_until_throw-- == 0)
+                throw std::runtime_error{"copy failed"};
+            ++live;
+        }
+
+        ThrowingCopy(ThrowingCopy&&) noexcept
+        {
+            ++live;
+        }
+
+        ThrowingCopy& operator=(const ThrowingCopy&) = default;
+        ThrowingCopy& operator=(ThrowingCopy&&) noexcept = default;
+
+        ~ThrowingCopy()
+        {
+            --live;
+        }
+    };
+}
+
+TEST_CASE("MpmcQueue - throwing copy doesn't block the queue")
+{
+    {
+        MpmcQueue<ThrowingCopy> queue{2};
+        ThrowingCopy item;
+
+        ThrowingCopy::copies_until_throw = 0;
+        REQUIRE_THROWS_AS(queue.try_push(item), std::runtime_error);
+        REQUIRE(ThrowingCopy::live == 1);
+
+        // no cell was claimed - the queue is still fully usable
+        for (int lap = 0; lap < 3; ++lap)
+        {
+            REQUIRE(queue.try_push(item));
+            REQUIRE(queue.try_push(item));
+            REQUIRE_FALSE(queue.try_push(item));
+
+            REQUIRE(queue.try_pop(item));
+            REQUIRE(queue.try_pop(item));
+            REQUIRE_FALSE(queue.try_pop(item));
+        }
+    }
+
+    ThrowingCopy::copies_until_throw = -1;
+    REQUIRE(ThrowingCopy::live == 0);
+}
+
+TEST_CASE("MpmcQueue - many producers & consumers")
+{
+    constexpr int count_per_producer = 20'000;
+
+    SECTION("try_push/try_pop")
+    {
+        MpmcQueue<int> queue{64};
+        REQUIRE(exchange(queue, 4, 4, count_per_producer) == expected_sum(4, count_per_producer));
+    }
+
+    SECTION("blocking push/pop")
+    {
+        BlockingMpmcQueue<int> queue{16};
+        std::atomic<long long> sum{0};
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 3; ++i)
+        {
+            threads.emplace_back([&queue] {
+                for (int value = 1; value <= count_per_producer; ++value)
+                    queue.push(value);
+            });
+        }
+
+        for (int i = 0; i < 2; ++i)
+        {
+            threads.emplace_back([&queue, &sum] {
+                long long local_sum{};
+                for (int j = 0; j < 3 * count_per_producer / 2; ++j)
+                {
+                    int value;
+                    queue.pop(value);
+                    local_sum += value;
+                }
+                sum += local_sum;
+            });
+        }
+
+        for (auto& t : threads)
+            t.join();
+
+        REQUIRE(sum == expected_sum(3, count_per_producer));
+    }
+}
+
+TEST_CASE("MPMC queues - benchmark", "[.benchmark]")
+{
+    constexpr int messages = 200'000;
+
+    for (unsigned int thread_count : {2U, 4U, 8U, 16U, 32U, 64U})
+    {
+        const unsigned int producers = thread_count / 2;
+        const unsigned int consumers = thread_count - producers;
+        const int count_per_producer = messages / static_cast<int>(producers);
+        const std::string suffix = " - " + std::to_string(thread_count) + " threads";
+
+        BENCHMARK("mutex + std::queue" + suffix)
+        {
+            MutexQueue<int> queue;
+            return exchange(queue, producers, consumers, count_per_producer);
+        };
+
+        BENCHMARK("MpmcQueue" + suffix)
+        {
+            MpmcQueue<int> queue{1024};
+            return exchange(queue, producers, consumers, count_per_producer);
+        };
+
+        BENCHMARK("BlockingMpmcQueue" + suffix)
+        {
+            BlockingMpmcQueue<int> queue{1024};
+            std::vector<std::thread> threads;
+
+            for (unsigned int i = 0; i < producers; ++i)
+            {
+                threads.emplace_back([&queue, count_per_producer] {
+                    for (int value = 1; value <= count_per_producer; ++value)
+                        queue.push(value);
+                });
+            }
+
+            std::atomic<long long> sum{0};
+            for (unsigned int i = 0; i < consumers; ++i)
+            {
+                // consumers split the messages - the first one takes the remainder
+                const long long count = static_cast<long long>(producers) * count_per_producer / consumers
+                    + (i == 0 ? static_cast<long long>(producers) * count_per_producer % consumers : 0);
+
+                threads.emplace_back([&queue, &sum, count] {
+                    long long local_sum{};
+                    for (long long j = 0; j < count; ++j)
+                    {
+                        int value;
+                        queue.pop(value);
+                        local_sum += value;
+                    }
+                    sum += local_sum;
+                });
+            }
+
+            for (auto& t : threads)
+                t.join();
+
+            return sum.load();
+        };
+    }
+}
+
+TEST_CASE("MessageQueue")
+{
+    SECTION("messages are moved out")
+    {
+        MessageQueue<> queue;
+        const std::string long_msg(100, 'x');
+
+        std::string msg = long_msg;
+        const char* buffer = msg.data();
+        queue.push(std::move(msg));
+
+        std::string popped;
+        REQUIRE(queue.try_pop(popped));
+        REQUIRE(popped == long_msg);
+        REQUIRE(popped.data() == buffer);
+        REQUIRE_FALSE(queue.try_pop(popped));
+    }
+
+    SECTION("bulk push & pop")
+    {
+        MessageQueue<> queue;
+        std::vector<std::string> messages = {"one", "two", "three", "four", "five"};
+        queue.push_bulk(std::make_move_iterator(messages.begin()), std::make_move_iterator(messages.end()));
+        REQUIRE(queue.size() == 5);
+
+        std::vector<std::string> batch(3);
+        REQUIRE(queue.pop_bulk(batch.begin(), batch.size()) == 3);
+        REQUIRE(batch == std::vector<std::string>{"one", "two", "three"});
+
+        REQUIRE(queue.pop_bulk(batch.begin(), batch.size()) == 2);
+        REQUIRE(batch[0] == "four");
+        REQUIRE(batch[1] == "five");
+
+        REQUIRE(queue.pop_bulk(batch.begin(), batch.size()) == 0);
+    }
+}
+
+TEST_CASE("MessageQueue - arena storage")
+{
+    MessageQueue<ArenaStorage> queue{ArenaStorage{64}};
+
+    SECTION("records wrap around the ring")
+    {
+        std::string msg;
+        for (int i = 0; i < 100; ++i)
+        {
+            queue.push("message #" + std::to_string(i));
+            queue.push(std::string_view{"second"});
+
+            REQUIRE(queue.try_pop(msg));
+            REQUIRE(msg == "message #" + std::to_string(i));
+            REQUIRE(queue.try_pop(msg));
+            REQUIRE(msg == "second");
+        }
+    }
+
+    SECTION("ring grows for large backlog")
+    {
+        std::vector<std::string> messages;
+        for (int i = 0; i < 50; ++i)
+            messages.push_back(std::string(static_cast<size_t>(i), static_cast<char>('a' + i % 26)));
+
+        queue.push_bulk(messages.begin(), messages.end());
+
+        std::vector<std::string> batch(64);
+        REQUIRE(queue.pop_bulk(batch.begin(), batch.size()) == 50);
+        REQUIRE(std::equal(messages.begin(), messages.end(), batch.begin()));
+    }
+
+    SECTION("strings are reused by consumer")
+    {
+        std::vector<std::string> batch(4, std::string(64, ' '));
+        const char* buffer = batch[0].data();
+
+        queue.push("short");
+        REQUIRE(queue.pop_bulk(batch.begin(), batch.size()) == 1);
+        REQUIRE(batch[0] == "short");
+        REQUIRE(batch[0].data() == buffer);
+    }
+}
+
+namespace
+{
+    std::vector<std::string> make_payloads(size_t count, size_t length)
+    {
+        std::vector<std::string> payloads;
+        for (size_t i = 0; i < count; ++i)
+        {
+            std::string payload = "msg#" + std::to_string(i);
+            payload.resize(length, '.');
+            payloads.push_back(std::move(payload));
+        }
+        return payloads;
+    }
+
+    // one producer thread, consumer runs on the calling thread; returns number of received messages
+    template <typename TProduce, typename TConsume>
+    size_t exchange_messages(TProduce produce, TConsume consume)
+    {
+        std::thread producer{produce};
+        const size_t received = consume();
+        producer.join();
+
+        return received;
+    }
+}
+
+// every run exchanges 200'000 messages - msgs/sec = 200'000 / mean time;
+// producers move strings from per-run copies of the payloads (the copies are made outside of measurement)
+TEST_CASE("MessageQueue - msgs/sec benchmark", "[.benchmark]")
+{
+    constexpr size_t messages = 200'000;
+    constexpr size_t batch_size = 64;
+
+    for (size_t length : {12, 64, 256})
+    {
+        const std::vector<std::string> payloads = make_payloads(messages, length);
+        const std::string suffix = " - " + std::to_string(length) + " byte messages";
+
+        BENCHMARK_ADVANCED("q_msg - copy & pop" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            std::vector<std::vector<std::string>> sources(meter.runs(), payloads);
+
+            meter.measure([&](int run) {
+                std::queue<std::string> q_msg;
+                std::mutex mtx_q_msg;
+
+                return exchange_messages(
+                    [&] {
+                        for (auto& payload : sources[run])
+                        {
+                            std::lock_guard lk{mtx_q_msg};
+                            q_msg.push(std::move(payload));
+                        }
+                    },
+                    [&] {
+                        std::string msg;
+                        size_t received = 0;
+                        while (received < messages)
+                        {
+                            if (std::lock_guard lk{mtx_q_msg}; !std::empty(q_msg))
+                            {
+                                msg = q_msg.front();
+                                q_msg.pop();
+                                ++received;
+                            }
+                        }
+                        return received;
+                    });
+            });
+        };
+
+        BENCHMARK_ADVANCED("MessageQueue - move & pop" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            std::vector<std::vector<std::string>> sources(meter.runs(), payloads);
+
+            meter.measure([&](int run) {
+                MessageQueue<> queue;
+
+                return exchange_messages(
+                    [&] {
+                        for (auto& payload : sources[run])
+                            queue.push(std::move(payload));
+                    },
+                    [&] {
+                        std::string msg;
+                        size_t received = 0;
+                        while (received < messages)
+                            received += queue.try_pop(msg);
+                        return received;
+                    });
+            });
+        };
+
+        auto consume_bulk = [](auto& queue) {
+            std::vector<std::string> batch(batch_size);
+            size_t received = 0;
+            while (received < messages)
+                received += queue.pop_bulk(batch.begin(), batch.size());
+            return received;
+        };
+
+        BENCHMARK_ADVANCED("MessageQueue - bulk move" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            std::vector<std::vector<std::string>> sources(meter.runs(), payloads);
+
+            meter.measure([&](int run) {
+                MessageQueue<> queue;
+                auto& source = sources[run];
+
+                return exchange_messages(
+                    [&] {
+                        for (size_t i = 0; i < messages; i += batch_size)
+                        {
+                            const auto first = std::make_move_iterator(source.begin() + i);
+                            const auto last = std::make_move_iterator(source.begin() + std::min(messages, i + batch_size));
+                            queue.push_bulk(first, last);
+                        }
+                    },
+                    [&] {
+                        return consume_bulk(queue);
+                    });
+            });
+        };
+
+        // payload bytes are copied into the ring - nothing to move
+        BENCHMARK("MessageQueue<ArenaStorage> - bulk" + suffix)
+        {
+            MessageQueue<ArenaStorage> queue;
+
+            return exchange_messages(
+                [&] {
+                    for (size_t i = 0; i < messages; i += batch_size)
+                        queue.push_bulk(payloads.begin() + i, payloads.begin() + std::min(messages, i + batch_size));
+                },
+                [&] {
+                    return consume_bulk(queue);
+                });
+        };
+    }
+}
+
+TEST_CASE("SpscQueue")
+{
+    SpscQueue<std::string> queue{3};
+    REQUIRE(queue.capacity() == 4);
+
+    SECTION("FIFO & full queue")
+    {
+        for (int i = 0; i < 4; ++i)
+            REQUIRE(queue.try_push(std::to_string(i)));
+
+        std::string rejected = "rejected";
+        REQUIRE_FALSE(queue.try_push(std::move(rejected)));
+        REQUIRE(rejected == "rejected");
+
+        std::string msg;
+        for (int i = 0; i < 4; ++i)
+        {
+            REQUIRE(queue.try_pop(msg));
+            REQUIRE(msg == std::to_string(i));
+        }
+        REQUIRE_FALSE(queue.try_pop(msg));
+    }
+
+    SECTION("bulk push stops when queue is full")
+    {
+        std::vector<std::string> messages = {"a", "b", "c", "d", "e", "f"};
+        auto rest = queue.try_push_bulk(messages.begin(), messages.end());
+        REQUIRE(rest == messages.begin() + 4);
+
+        std::vector<std::string> batch(3);
+        REQUIRE(queue.try_pop_bulk(batch.begin(), batch.size()) == 3);
+        REQUIRE(batch == std::vector<std::string>{"a", "b", "c"});
+
+        rest = queue.try_push_bulk(rest, messages.end());
+        REQUIRE(rest == messages.end());
+
+        REQUIRE(queue.try_pop_bulk(batch.begin(), batch.size()) == 3);
+        REQUIRE(batch == std::vector<std::string>{"d", "e", "f"});
+        REQUIRE(queue.try_pop_bulk(batch.begin(), batch.size()) == 0);
+    }
+
+    SECTION("wraps around many laps")
+    {
+        std::vector<std::string> batch(3);
+        for (int i = 0; i < 100; ++i)
+        {
+            std::vector<std::string> messages = {std::to_string(i), "x", "y"};
+            queue.try_push_bulk(std::make_move_iterator(messages.begin()), std::make_move_iterator(messages.end()));
+
+            REQUIRE(queue.try_pop_bulk(batch.begin(), batch.size()) == 3);
+            REQUIRE(batch[0] == std::to_string(i));
+        }
+    }
+}
+
+TEST_CASE("SpscQueue - throwing constructor in bulk push")
+{
+    SpscQueue<ThrowingCopy> queue{8};
+    {
+        std::vector<ThrowingCopy> items(5);
+        ThrowingCopy::copies_until_throw = 3;
+
+        REQUIRE_THROWS_AS(queue.try_push_bulk(items.begin(), items.end()), std::runtime_error);
+        REQUIRE(ThrowingCopy::live == 5); // copies made before the exception are destroyed
+
+        ThrowingCopy item;
+        REQUIRE_FALSE(queue.try_pop(item)); // nothing published
+    }
+
+    ThrowingCopy::copies_until_throw = -1;
+    REQUIRE(ThrowingCopy::live == 0);
+}
+
+TEST_CASE("SpscQueue - items left in queue are destroyed")
+{
+    auto counter = std::make_shared<int>(0);
+    {
+        SpscQueue<std::shared_ptr<int>> queue{4};
+        queue.try_push(counter);
+        queue.try_push(counter);
+        REQUIRE(counter.use_count() == 3);
+    }
+    REQUIRE(counter.use_count() == 1);
+}
+
+TEST_CASE("SpscQueue - producer & consumer threads")
+{
+    constexpr int count = 100'000;
+
+    SECTION("single items keep order")
+    {
+        SpscQueue<int> queue{16};
+
+        std::thread producer{[&queue] {
+            for (int value = 0; value < count; ++value)
+            {
+                while (!queue.try_push(value))
+                    std::this_thread::yield();
+            }
+        }};
+
+        int errors = 0;
+        int value;
+        for (int expected = 0; expected < count;)
+        {
+            if (queue.try_pop(value))
+                errors += value != expected++;
+            else
+                std::this_thread::yield();
+        }
+        producer.join();
+
+        REQUIRE(errors == 0);
+    }
+
+    SECTION("bulk")
+    {
+        SpscQueue<int> queue{64};
+
+        std::thread producer{[&queue] {
+            std::vector<int> batch(10);
+            for (int first = 0; first < count; first += 10)
+            {
+                std::iota(batch.begin(), batch.end(), first);
+                for (auto pos = batch.begin(); pos != batch.end();)
+                {
+                    pos = queue.try_push_bulk(pos, batch.end());
+                    if (pos != batch.end())
+                        std::this_thread::yield();
+                }
+            }
+        }};
+
+        int errors = 0;
+        std::vector<int> batch(32);
+        for (int expected = 0; expected < count;)
+        {
+            const size_t popped = queue.try_pop_bulk(batch.begin(), batch.size());
+            if (popped == 0)
+                std::this_thread::yield();
+
+            for (size_t i = 0; i < popped; ++i)
+                errors += batch[i] != expected++;
+        }
+        producer.join();
+
+        REQUIRE(errors == 0);
+    }
+}
+
+namespace
+{
+    // one-way latency of handing a timestamp to the consumer; the producer sends
+    // the next item after the previous one was received
+    template <typename TQueue>
+    std::vector<long long> handoff_latencies(TQueue& queue, int samples)
+    {
+        using namespace std::chrono;
+
+        std::vector<long long> latencies;
+        latencies.reserve(samples);
+        std::atomic<int> received{0};
+
+        std::thread consumer{[&] {
+            long long sent;
+            while (received.load(std::memory_order_relaxed) < samples)
+            {
+                if (queue.try_pop(sent))
+                {
+                    latencies.push_back(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count() - sent);
+                    received.fetch_add(1, std::memory_order_release);
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }};
+
+        for (int i = 0; i < samples; ++i)
+        {
+            const long long now = duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+            while (!queue.try_push(now))
+                std::this_thread::yield();
+
+            while (received.load(std::memory_order_acquire) <= i)
+                std::this_thread::yield();
+        }
+
+        consumer.join();
+        return latencies;
+    }
+
+    // p50/p99/p999 and a log2 histogram of latencies
+    std::string latency_histogram(const std::string& name, std::vector<long long> latencies)
+    {
+        std::sort(latencies.begin(), latencies.end());
+
+        auto percentile = [&latencies](double p) {
+            return latencies[static_cast<size_t>(p * (latencies.size() - 1))];
+        };
+
+        std::ostringstream report;
+        report << name << ": p50 = " << percentile(0.5) << " ns, p99 = " << percentile(0.99)
+               << " ns, p999 = " << percentile(0.999) << " ns\n";
+
+        std::vector<size_t> buckets(64);
+        for (long long latency : latencies)
+        {
+            size_t bucket = 0;
+            while ((latency >> bucket) > 1)
+                ++bucket;
+            ++buckets[bucket];
+        }
+
+        for (size_t bucket = 0; bucket < buckets.size(); ++bucket)
+        {
+            if (buckets[bucket] != 0)
+                report << "    < " << std::setw(12) << (2LL << bucket) << " ns: " << std::setw(8) << buckets[bucket] << "\n";
+        }
+
+        return report.str();
+    }
+}
+
+// results are reported with WARN - percentiles and histograms don't fit into BENCHMARK
+TEST_CASE("SPSC queues - latency histograms", "[.benchmark]")
+{
+    constexpr int samples = 100'000;
+
+    MutexQueue<long long> mutex_queue;
+    WARN(latency_histogram("mutex + std::queue", handoff_latencies(mutex_queue, samples)));
+
+    MpmcQueue<long long> mpmc_queue{1024};
+    WARN(latency_histogram("MpmcQueue", handoff_latencies(mpmc_queue, samples)));
+
+    SpscQueue<long long> spsc_queue{1024};
+    WARN(latency_histogram("SpscQueue", handoff_latencies(spsc_queue, samples)));
+}
+
+TEST_CASE("SPSC queues - throughput benchmark", "[.benchmark]")
+{
+    constexpr int messages = 1'000'000;
+    constexpr int batch_size = 64;
+
+    BENCHMARK("mutex + std::queue")
+    {
+        MutexQueue<int> queue;
+        return exchange(queue, 1, 1, messages);
+    };
+
+    BENCHMARK("MpmcQueue")
+    {
+        MpmcQueue<int> queue{1024};
+        return exchange(queue, 1, 1, messages);
+    };
+
+    BENCHMARK("SpscQueue")
+    {
+        SpscQueue<int> queue{1024};
+        return exchange(queue, 1, 1, messages);
+    };
+
+    BENCHMARK("SpscQueue - bulk")
+    {
+        SpscQueue<int> queue{1024};
+
+        std::thread producer{[&queue] {
+            std::vector<int> batch(batch_size);
+            for (int first = 1; first <= messages; first += batch_size)
+            {
+                std::iota(batch.begin(), batch.end(), first);
+                for (auto pos = batch.begin(); pos != batch.end();)
+                {
+                    pos = queue.try_push_bulk(pos, batch.end());
+                    if (pos != batch.end())
+                        std::this_thread::yield();
+                }
+            }
+        }};
+
+        long long sum{};
+        std::vector<int> batch(batch_size);
+        for (long long received = 0; received < messages;)
+        {
+            const size_t popped = queue.try_pop_bulk(batch.begin(), batch.size());
+            if (popped == 0)
+                std::this_thread::yield();
+
+            sum = std::accumulate(batch.begin(), batch.begin() + popped, sum);
+            received += popped;
+        }
+
+        producer.join();
+        return sum;
+    };
+}
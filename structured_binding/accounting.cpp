@@ -0,0 +1,100 @@
+#include "accounting.hpp"
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    void* counted_malloc(size_t size) noexcept
+    {
+        ++Accounting::counters.allocations;
+        Accounting::counters.bytes_allocated += size;
+
+        return std::malloc(size ? size : 1);
+    }
+
+    void* counted_aligned_alloc(size_t size, std::align_val_t alignment) noexcept
+    {
+        ++Accounting::counters.allocations;
+        Accounting::counters.bytes_allocated += size;
+
+        const size_t align = static_cast<size_t>(alignment);
+        return std::aligned_alloc(align, (size + align - 1) / align * align);
+    }
+}
+
+void* operator new(size_t size)
+{
+    if (void* ptr = counted_malloc(size))
+        return ptr;
+
+    throw std::bad_alloc{};
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return counted_malloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return counted_malloc(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    if (void* ptr = counted_aligned_alloc(size, alignment))
+        return ptr;
+
+    throw std::bad_alloc{};
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
@@ -0,0 +1,153 @@
+#ifndef ACCOUNTING_HPP
+#define ACCOUNTING_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// per-thread counters of copies, moves and heap allocations;
+// allocations are counted by the global operator new replacement in accounting.cpp
+namespace Accounting
+{
+    struct Counters
+    {
+        size_t copy_constructions{};
+        size_t move_constructions{};
+        size_t copy_assignments{};
+        size_t move_assignments{};
+        size_t allocations{};
+        size_t bytes_allocated{};
+
+        size_t copies() const noexcept
+        {
+            return copy_constructions + copy_assignments;
+        }
+
+        size_t moves() const noexcept
+        {
+            return move_constructions + move_assignments;
+        }
+
+        friend Counters operator-(const Counters& lhs, const Counters& rhs) noexcept
+        {
+            return Counters{lhs.copy_constructions - rhs.copy_constructions,
+                lhs.move_constructions - rhs.move_constructions,
+                lhs.copy_assignments - rhs.copy_assignments,
+                lhs.move_assignments - rhs.move_assignments,
+                lhs.allocations - rhs.allocations,
+                lhs.bytes_allocated - rhs.bytes_allocated};
+        }
+    };
+
+    inline thread_local Counters counters{};
+
+    // counts what happened on the current thread since construction
+    class Scope
+    {
+        Counters start_;
+
+    public:
+        Scope() noexcept
+            : start_{counters}
+        {
+        }
+
+        Counters delta() const noexcept
+        {
+            return counters - start_;
+        }
+    };
+
+    // wrapper counting copies and moves of any value type
+    template <typename T>
+    class Tracked
+    {
+        T value_;
+
+    public:
+        template <typename... TArgs>
+        explicit Tracked(std::in_place_t, TArgs&&... args)
+            : value_(std::forward<TArgs>(args)...)
+        {
+        }
+
+        Tracked(T value)
+            : value_(std::move(value))
+        {
+        }
+
+        Tracked(const Tracked& other)
+            : value_(other.value_)
+        {
+            ++counters.copy_constructions;
+        }
+
+        Tracked(Tracked&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+            : value_(std::move(other.value_))
+        {
+            ++counters.move_constructions;
+        }
+
+        Tracked& operator=(const Tracked& other)
+        {
+            value_ = other.value_;
+            ++counters.copy_assignments;
+            return *this;
+        }
+
+        Tracked& operator=(Tracked&& other) noexcept(std::is_nothrow_move_assignable_v<T>)
+        {
+            value_ = std::move(other.value_);
+            ++counters.move_assignments;
+            return *this;
+        }
+
+        T& get() noexcept
+        {
+            return value_;
+        }
+
+        const T& get() const noexcept
+        {
+            return value_;
+        }
+    };
+
+    // trace policy for BasicArray - reports lifecycle events to the counters
+    struct AccountingTrace
+    {
+        static void constructed(const int*, size_t) noexcept
+        {
+        }
+
+        static void list_constructed(const int*, size_t) noexcept
+        {
+        }
+
+        static void copy_constructed(const int*, size_t) noexcept
+        {
+            ++counters.copy_constructions;
+        }
+
+        static void copy_assigned(const int*, size_t) noexcept
+        {
+            ++counters.copy_assignments;
+        }
+
+        static void move_constructed(const int*) noexcept
+        {
+            ++counters.move_constructions;
+        }
+
+        static void move_assigned(const int*) noexcept
+        {
+            ++counters.move_assignments;
+        }
+
+        static void destroyed(const int*) noexcept
+        {
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,359 @@
+#ifndef ARRAY_HPP
+#define ARRAY_HPP
+
+#include "array_simd.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iostream>
+#include <memory_resource>
+
+// tag for constructors that leave items uninitialized - caller overwrites every item
+struct Uninitialized
+{
+    explicit Uninitialized() = default;
+};
+
+inline constexpr Uninitialized uninitialized{};
+
+// trace policies - hooks called on every lifecycle event of BasicArray
+struct NoTrace
+{
+    static void constructed(const int*, size_t) noexcept
+    {
+    }
+
+    static void list_constructed(const int*, size_t) noexcept
+    {
+    }
+
+    static void copy_constructed(const int*, size_t) noexcept
+    {
+    }
+
+    static void copy_assigned(const int*, size_t) noexcept
+    {
+    }
+
+    static void move_constructed(const int*) noexcept
+    {
+    }
+
+    static void move_assigned(const int*) noexcept
+    {
+    }
+
+    static void destroyed(const int*) noexcept
+    {
+    }
+};
+
+struct TraceCounters
+{
+    size_t constructions{};
+    size_t copy_constructions{};
+    size_t copy_assignments{};
+    size_t move_constructions{};
+    size_t move_assignments{};
+    size_t destructions{};
+};
+
+struct CountingTrace
+{
+    static inline TraceCounters counters{};
+
+    static void reset() noexcept
+    {
+        counters = TraceCounters{};
+    }
+
+    static void constructed(const int*, size_t) noexcept
+    {
+        ++counters.constructions;
+    }
+
+    static void list_constructed(const int*, size_t) noexcept
+    {
+        ++counters.constructions;
+    }
+
+    static void copy_constructed(const int*, size_t) noexcept
+    {
+        ++counters.copy_constructions;
+    }
+
+    static void copy_assigned(const int*, size_t) noexcept
+    {
+        ++counters.copy_assignments;
+    }
+
+    static void move_constructed(const int*) noexcept
+    {
+        ++counters.move_constructions;
+    }
+
+    static void move_assigned(const int*) noexcept
+    {
+        ++counters.move_assignments;
+    }
+
+    static void destroyed(const int*) noexcept
+    {
+        ++counters.destructions;
+    }
+};
+
+struct FullTrace
+{
+    static void print_items(const int* items, size_t size)
+    {
+        std::cout << "{ ";
+        for (size_t i = 0; i < size; ++i)
+            std::cout << items[i] << " ";
+        std::cout << "}";
+    }
+
+    static void constructed(const int* items, size_t size)
+    {
+        std::cout << "Array(size: " << size << ", @" << items << ")\n";
+    }
+
+    static void list_constructed(const int* items, size_t size)
+    {
+        std::cout << "Array(";
+        print_items(items, size);
+        std::cout << ", @" << items << ")\n";
+    }
+
+    static void copy_constructed(const int* items, size_t size)
+    {
+        std::cout << "Array(cc: ";
+        print_items(items, size);
+        std::cout << ", @" << items << ")\n";
+    }
+
+    static void copy_assigned(const int* items, size_t size)
+    {
+        std::cout << "Array::operator=(cc: ";
+        print_items(items, size);
+        std::cout << ", @" << items << ")\n";
+    }
+
+    static void move_constructed(const int* items)
+    {
+        std::cout << "Array(mv: @" << items << ")\n";
+    }
+
+    static void move_assigned(const int* items)
+    {
+        std::cout << "Array::operator=(mv: @" << items << ")\n";
+    }
+
+    static void destroyed(const int* items)
+    {
+        std::cout << "~Array(@";
+        if (items)
+            std::cout << items;
+        else
+            std::cout << "nullptr - state after move";
+        std::cout << ")\n";
+    }
+};
+
+//////////////////////////////////////////////
+// Array with move semantics
+// storage comes from a std::pmr::memory_resource (default resource if not given),
+// e.g. std::pmr::unsynchronized_pool_resource serves repeated sizes from size-class pools;
+// TTrace selects lifecycle hooks - NoTrace compiles to a plain container;
+// items are 32-byte aligned for the bulk SIMD operations
+
+template <typename TTrace>
+class BasicArray
+{
+    static constexpr size_t alignment = 32;
+
+    std::pmr::memory_resource* resource_;
+    int* items_;
+    size_t size_;
+
+    static int* allocate(std::pmr::memory_resource* resource, size_t size)
+    {
+        return static_cast<int*>(resource->allocate(size * sizeof(int), alignment));
+    }
+
+    void deallocate() noexcept
+    {
+        if (items_)
+            resource_->deallocate(items_, size_ * sizeof(int), alignment);
+    }
+
+public:
+    BasicArray(size_t size, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : resource_{resource}
+        , items_{allocate(resource, size)}
+        , size_{size}
+    {
+        fill(0);
+        TTrace::constructed(items_, size_);
+    }
+
+    BasicArray(size_t size, Uninitialized, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : resource_{resource}
+        , items_{allocate(resource, size)}
+        , size_{size}
+    {
+        TTrace::constructed(items_, size_);
+    }
+
+    BasicArray(std::initializer_list<int> il, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : resource_{resource}
+        , items_{allocate(resource, il.size())}
+        , size_{il.size()}
+    {
+        std::copy(il.begin(), il.end(), items_);
+        TTrace::list_constructed(items_, size_);
+    }
+
+    // copy constructor - like pmr containers the copy uses the default resource
+    BasicArray(const BasicArray& source)
+        : resource_{std::pmr::get_default_resource()}
+        , items_{allocate(resource_, source.size())}
+        , size_{source.size()}
+    {
+        std::copy_n(source.items_, size_, items_);
+        TTrace::copy_constructed(items_, size_);
+    }
+
+    // copy assignment
+    BasicArray& operator=(const BasicArray& source)
+    {
+        if (this != &source)
+        {
+            int* items = allocate(resource_, source.size());
+            deallocate();
+
+            items_ = items;
+            size_ = source.size();
+
+            std::copy_n(source.items_, size_, items_);
+            TTrace::copy_assigned(items_, size_);
+        }
+
+        return *this;
+    }
+
+    // move constructor
+    BasicArray(BasicArray&& source) noexcept
+        : resource_{source.resource_}
+        , items_{source.items_}
+        , size_{source.size_}
+    {
+        source.items_ = nullptr;
+        source.size_ = 0;
+
+        TTrace::move_constructed(items_);
+    }
+
+    // move assignment - buffers from other resource can't be adopted, items are copied
+    BasicArray& operator=(BasicArray&& source)
+    {
+        if (this != &source)
+        {
+            if (resource_ != source.resource_ && !resource_->is_equal(*source.resource_))
+                return *this = static_cast<const BasicArray&>(source);
+
+            deallocate();
+
+            items_ = std::move(source.items_);
+            size_ = std::move(source.size_);
+
+            source.items_ = nullptr;
+            source.size_ = 0;
+
+            TTrace::move_assigned(items_);
+        }
+
+        return *this;
+    }
+
+    ~BasicArray()
+    {
+        TTrace::destroyed(items_);
+
+        deallocate();
+    }
+
+    std::pmr::memory_resource* resource() const noexcept
+    {
+        return resource_;
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    int* data() const
+    {
+        return items_;
+    }
+
+    int& operator[](size_t index)
+    {
+        return items_[index];
+    }
+
+    const int& operator[](size_t index) const
+    {
+        return items_[index];
+    }
+
+    // bulk operations
+    void fill(int value) noexcept
+    {
+        Simd::fill(items_, size_, value);
+    }
+
+    // items_[i] = start + i
+    void iota(int start = 0) noexcept
+    {
+        Simd::iota(items_, size_, start);
+    }
+
+    // copies count items to the beginning of the array
+    void copy_from(const int* source, size_t count) noexcept
+    {
+        assert(count <= size_);
+        Simd::copy(items_, source, count);
+    }
+
+    int64_t sum() const noexcept
+    {
+        return Simd::sum(items_, size_);
+    }
+
+    // precondition: other.size() == size()
+    int64_t dot(const BasicArray& other) const noexcept
+    {
+        assert(other.size_ == size_);
+        return Simd::dot(items_, other.items_, size_);
+    }
+
+    void scale(int factor) noexcept
+    {
+        Simd::scale(items_, size_, factor);
+    }
+
+    void clamp(int low, int high) noexcept
+    {
+        assert(low <= high);
+        Simd::clamp(items_, size_, low, high);
+    }
+};
+
+using Array = BasicArray<FullTrace>;
+
+#endif
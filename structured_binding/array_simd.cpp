@@ -0,0 +1,232 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "array.hpp"
+
+#include <algorithm>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <climits>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+    using FastArray = BasicArray<NoTrace>;
+
+    FastArray make_random_array(size_t size, unsigned int seed = 42)
+    {
+        std::mt19937 rnd{seed};
+        std::uniform_int_distribution<int> distribution{INT_MIN, INT_MAX};
+
+        FastArray arr(size, uninitialized);
+        std::generate(arr.data(), arr.data() + arr.size(), [&] { return distribution(rnd); });
+        return arr;
+    }
+
+    constexpr size_t sizes[] = {0, 1, 7, 8, 9, 31, 1000, 1003}; // tails of the SIMD loops
+
+    bool equal_items(const FastArray& arr, const std::vector<int>& expected)
+    {
+        return std::equal(arr.data(), arr.data() + arr.size(), expected.begin(), expected.end());
+    }
+}
+
+TEST_CASE("Array - bulk operations")
+{
+    SECTION("items are 32-byte aligned")
+    {
+        for (size_t size : sizes)
+        {
+            FastArray arr(size);
+            REQUIRE(reinterpret_cast<uintptr_t>(arr.data()) % 32 == 0);
+        }
+    }
+
+    SECTION("fill")
+    {
+        for (size_t size : sizes)
+        {
+            FastArray arr(size, uninitialized);
+            arr.fill(-7);
+            REQUIRE(std::all_of(arr.data(), arr.data() + size, [](int x) { return x == -7; }));
+        }
+    }
+
+    SECTION("iota")
+    {
+        for (size_t size : sizes)
+        {
+            FastArray arr(size, uninitialized);
+            arr.iota(INT_MAX - 3);
+
+            std::vector<int> expected(size);
+            Simd::Scalar::iota(expected.data(), size, INT_MAX - 3);
+            REQUIRE(equal_items(arr, expected));
+            if (size > 4)
+                REQUIRE(arr[4] == INT_MIN);
+        }
+    }
+
+    SECTION("copy_from")
+    {
+        for (size_t size : sizes)
+        {
+            std::vector<int> source(size + 1);
+            std::iota(source.begin(), source.end(), 100);
+
+            FastArray arr(size, uninitialized);
+            arr.copy_from(source.data() + 1, size); // unaligned source
+            REQUIRE(equal_items(arr, std::vector<int>(source.begin() + 1, source.end())));
+        }
+    }
+
+    SECTION("sum & dot - no overflow in 64-bit accumulators")
+    {
+        for (size_t size : sizes)
+        {
+            const FastArray a = make_random_array(size, 1);
+            const FastArray b = make_random_array(size, 2);
+
+            REQUIRE(a.sum() == std::accumulate(a.data(), a.data() + size, int64_t{}));
+            REQUIRE(a.dot(b) == Simd::Scalar::dot(a.data(), b.data(), size));
+
+            FastArray max_items(size);
+            max_items.fill(INT_MAX);
+            REQUIRE(max_items.sum() == int64_t{INT_MAX} * static_cast<int64_t>(size));
+        }
+    }
+
+    SECTION("scale")
+    {
+        for (size_t size : sizes)
+        {
+            FastArray arr = make_random_array(size);
+            std::vector<int> expected(arr.data(), arr.data() + size);
+            Simd::Scalar::scale(expected.data(), size, -3);
+
+            arr.scale(-3);
+            REQUIRE(equal_items(arr, expected));
+        }
+    }
+
+    SECTION("clamp")
+    {
+        for (size_t size : sizes)
+        {
+            FastArray arr = make_random_array(size);
+            std::vector<int> expected(arr.data(), arr.data() + size);
+            for (auto& x : expected)
+                x = std::clamp(x, -1000, 1000);
+
+            arr.clamp(-1000, 1000);
+            REQUIRE(equal_items(arr, expected));
+        }
+    }
+}
+
+// sizes from L1-resident (16 KB) to DRAM-resident (256 MB)
+TEST_CASE("Array - bulk operations benchmark", "[.benchmark]")
+{
+    for (size_t size : {4 * 1024, 64 * 1024, 1024 * 1024, 64 * 1024 * 1024})
+    {
+        const std::string suffix = " - " + std::to_string(size * sizeof(int) / 1024) + " KB";
+
+        FastArray a = make_random_array(size, 1);
+        const FastArray b = make_random_array(size, 2);
+
+        BENCHMARK("naive fill" + suffix)
+        {
+            for (size_t i = 0; i < a.size(); ++i)
+                a[i] = 42;
+            return a[0];
+        };
+
+        BENCHMARK("Array::fill" + suffix)
+        {
+            a.fill(42);
+            return a[0];
+        };
+
+        BENCHMARK("naive iota" + suffix)
+        {
+            for (size_t i = 0; i < a.size(); ++i)
+                a[i] = static_cast<int>(i);
+            return a[0];
+        };
+
+        BENCHMARK("Array::iota" + suffix)
+        {
+            a.iota();
+            return a[0];
+        };
+
+        BENCHMARK("naive copy" + suffix)
+        {
+            for (size_t i = 0; i < a.size(); ++i)
+                a[i] = b[i];
+            return a[0];
+        };
+
+        BENCHMARK("Array::copy_from" + suffix)
+        {
+            a.copy_from(b.data(), b.size());
+            return a[0];
+        };
+
+        BENCHMARK("naive sum" + suffix)
+        {
+            int64_t result{};
+            for (size_t i = 0; i < b.size(); ++i)
+                result += b[i];
+            return result;
+        };
+
+        BENCHMARK("Array::sum" + suffix)
+        {
+            return b.sum();
+        };
+
+        BENCHMARK("naive dot" + suffix)
+        {
+            uint64_t result{}; // wraps like the SIMD version instead of signed overflow
+            for (size_t i = 0; i < b.size(); ++i)
+                result += static_cast<uint64_t>(int64_t{a[i]} * b[i]);
+            return static_cast<int64_t>(result);
+        };
+
+        BENCHMARK("Array::dot" + suffix)
+        {
+            return a.dot(b);
+        };
+
+        BENCHMARK("naive scale" + suffix)
+        {
+            for (size_t i = 0; i < a.size(); ++i)
+                a[i] = static_cast<int>(static_cast<unsigned int>(a[i]) * 3U);
+            return a[0];
+        };
+
+        BENCHMARK("Array::scale" + suffix)
+        {
+            a.scale(3);
+            return a[0];
+        };
+
+        BENCHMARK("naive clamp" + suffix)
+        {
+            for (size_t i = 0; i < a.size(); ++i)
+                a[i] = std::clamp(a[i], -1000, 1000);
+            return a[0];
+        };
+
+        BENCHMARK("Array::clamp" + suffix)
+        {
+            a.clamp(-1000, 1000);
+            return a[0];
+        };
+    }
+}
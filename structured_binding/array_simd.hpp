@@ -0,0 +1,238 @@
+#ifndef ARRAY_SIMD_HPP
+#define ARRAY_SIMD_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define ARRAY_SIMD_AVX2 1
+#include <immintrin.h>
+#endif
+
+// bulk kernels for int arrays - AVX2 path selected at runtime (compiled with a target attribute,
+// so no special build flags are needed), scalar fallback elsewhere;
+// integer overflow wraps around in both paths
+namespace Simd
+{
+    namespace Scalar
+    {
+        inline void fill(int* items, size_t size, int value) noexcept
+        {
+            std::fill_n(items, size, value);
+        }
+
+        inline void iota(int* items, size_t size, int start) noexcept
+        {
+            for (size_t i = 0; i < size; ++i)
+                items[i] = static_cast<int>(static_cast<unsigned int>(start) + static_cast<unsigned int>(i));
+        }
+
+        inline void copy(int* items, const int* source, size_t size) noexcept
+        {
+            std::copy_n(source, size, items);
+        }
+
+        inline int64_t sum(const int* items, size_t size) noexcept
+        {
+            int64_t result{};
+            for (size_t i = 0; i < size; ++i)
+                result += items[i];
+            return result;
+        }
+
+        inline int64_t dot(const int* a, const int* b, size_t size) noexcept
+        {
+            uint64_t result{};
+            for (size_t i = 0; i < size; ++i)
+                result += static_cast<uint64_t>(int64_t{a[i]} * b[i]);
+            return static_cast<int64_t>(result);
+        }
+
+        inline void scale(int* items, size_t size, int factor) noexcept
+        {
+            for (size_t i = 0; i < size; ++i)
+                items[i] = static_cast<int>(static_cast<unsigned int>(items[i]) * static_cast<unsigned int>(factor));
+        }
+
+        inline void clamp(int* items, size_t size, int low, int high) noexcept
+        {
+            for (size_t i = 0; i < size; ++i)
+                items[i] = std::clamp(items[i], low, high);
+        }
+    }
+
+#ifdef ARRAY_SIMD_AVX2
+    namespace Avx2
+    {
+        constexpr size_t width = 8;
+
+        __attribute__((target("avx2"))) inline __m256i load(const int* items) noexcept
+        {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(items));
+        }
+
+        __attribute__((target("avx2"))) inline void store(int* items, __m256i block) noexcept
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(items), block);
+        }
+
+        __attribute__((target("avx2"))) inline int64_t horizontal_sum(__m256i lanes) noexcept
+        {
+            alignas(32) int64_t values[4];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(values), lanes);
+            return static_cast<int64_t>(static_cast<uint64_t>(values[0]) + values[1] + values[2] + values[3]);
+        }
+
+        __attribute__((target("avx2"))) inline void fill(int* items, size_t size, int value) noexcept
+        {
+            const __m256i block = _mm256_set1_epi32(value);
+
+            size_t i = 0;
+            for (; i + width <= size; i += width)
+                store(items + i, block);
+
+            Scalar::fill(items + i, size - i, value);
+        }
+
+        __attribute__((target("avx2"))) inline void iota(int* items, size_t size, int start) noexcept
+        {
+            const __m256i step = _mm256_set1_epi32(width);
+            __m256i block = _mm256_add_epi32(_mm256_set1_epi32(start), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+
+            size_t i = 0;
+            for (; i + width <= size; i += width)
+            {
+                store(items + i, block);
+                block = _mm256_add_epi32(block, step);
+            }
+
+            Scalar::iota(items + i, size - i, static_cast<int>(static_cast<unsigned int>(start) + static_cast<unsigned int>(i)));
+        }
+
+        __attribute__((target("avx2"))) inline void copy(int* items, const int* source, size_t size) noexcept
+        {
+            size_t i = 0;
+            for (; i + width <= size; i += width)
+                store(items + i, load(source + i));
+
+            Scalar::copy(items + i, source + i, size - i);
+        }
+
+        // items are widened to 64-bit lanes
+        __attribute__((target("avx2"))) inline int64_t sum(const int* items, size_t size) noexcept
+        {
+            __m256i low_sum = _mm256_setzero_si256();
+            __m256i high_sum = _mm256_setzero_si256();
+
+            size_t i = 0;
+            for (; i + width <= size; i += width)
+            {
+                const __m256i block = load(items + i);
+                low_sum = _mm256_add_epi64(low_sum, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(block)));
+                high_sum = _mm256_add_epi64(high_sum, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(block, 1)));
+            }
+
+            return horizontal_sum(_mm256_add_epi64(low_sum, high_sum)) + Scalar::sum(items + i, size - i);
+        }
+
+        // _mm256_mul_epi32 multiplies even lanes into 64-bit products - odd lanes are shifted down first
+        __attribute__((target("avx2"))) inline int64_t dot(const int* a, const int* b, size_t size) noexcept
+        {
+            __m256i even_sum = _mm256_setzero_si256();
+            __m256i odd_sum = _mm256_setzero_si256();
+
+            size_t i = 0;
+            for (; i + width <= size; i += width)
+            {
+                const __m256i a_block = load(a + i);
+                const __m256i b_block = load(b + i);
+                even_sum = _mm256_add_epi64(even_sum, _mm256_mul_epi32(a_block, b_block));
+                odd_sum = _mm256_add_epi64(odd_sum, _mm256_mul_epi32(_mm256_srli_epi64(a_block, 32), _mm256_srli_epi64(b_block, 32)));
+            }
+
+            return horizontal_sum(_mm256_add_epi64(even_sum, odd_sum)) + Scalar::dot(a + i, b + i, size - i);
+        }
+
+        __attribute__((target("avx2"))) inline void scale(int* items, size_t size, int factor) noexcept
+        {
+            const __m256i factors = _mm256_set1_epi32(factor);
+
+            size_t i = 0;
+            for (; i + width <= size; i += width)
+                store(items + i, _mm256_mullo_epi32(load(items + i), factors));
+
+            Scalar::scale(items + i, size - i, factor);
+        }
+
+        __attribute__((target("avx2"))) inline void clamp(int* items, size_t size, int low, int high) noexcept
+        {
+            const __m256i lows = _mm256_set1_epi32(low);
+            const __m256i highs = _mm256_set1_epi32(high);
+
+            size_t i = 0;
+            for (; i + width <= size; i += width)
+                store(items + i, _mm256_min_epi32(_mm256_max_epi32(load(items + i), lows), highs));
+
+            Scalar::clamp(items + i, size - i, low, high);
+        }
+    }
+#endif
+
+    inline bool has_avx2() noexcept
+    {
+#if defined(__AVX2__)
+        return true;
+#elif defined(ARRAY_SIMD_AVX2)
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+#ifdef ARRAY_SIMD_AVX2
+#define ARRAY_SIMD_DISPATCH(kernel, ...) return has_avx2() ? Avx2::kernel(__VA_ARGS__) : Scalar::kernel(__VA_ARGS__)
+#else
+#define ARRAY_SIMD_DISPATCH(kernel, ...) return Scalar::kernel(__VA_ARGS__)
+#endif
+
+    inline void fill(int* items, size_t size, int value) noexcept
+    {
+        ARRAY_SIMD_DISPATCH(fill, items, size, value);
+    }
+
+    inline void iota(int* items, size_t size, int start) noexcept
+    {
+        ARRAY_SIMD_DISPATCH(iota, items, size, start);
+    }
+
+    inline void copy(int* items, const int* source, size_t size) noexcept
+    {
+        ARRAY_SIMD_DISPATCH(copy, items, source, size);
+    }
+
+    inline int64_t sum(const int* items, size_t size) noexcept
+    {
+        ARRAY_SIMD_DISPATCH(sum, items, size);
+    }
+
+    inline int64_t dot(const int* a, const int* b, size_t size) noexcept
+    {
+        ARRAY_SIMD_DISPATCH(dot, a, b, size);
+    }
+
+    inline void scale(int* items, size_t size, int factor) noexcept
+    {
+        ARRAY_SIMD_DISPATCH(scale, items, size, factor);
+    }
+
+    inline void clamp(int* items, size_t size, int low, int high) noexcept
+    {
+        ARRAY_SIMD_DISPATCH(clamp, items, size, low, high);
+    }
+
+#undef ARRAY_SIMD_DISPATCH
+}
+
+#endif
@@ -0,0 +1,143 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "array.hpp"
+#include "huge_pages.hpp"
+
+#include <algorithm>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+namespace
+{
+    using FastArray = BasicArray<NoTrace>;
+
+    bool all_equal(const int* items, size_t size, int value)
+    {
+        return std::all_of(items, items + size, [value](int x) { return x == value; });
+    }
+}
+
+TEST_CASE("HugePageResource")
+{
+    const auto modes = {HugePageResource::Mode::transparent, HugePageResource::Mode::huge_tlb};
+
+    SECTION("small blocks come from upstream")
+    {
+        for (auto mode : modes)
+        {
+            HugePageResource huge_pages{mode};
+
+            FastArray arr({1, 2, 3}, &huge_pages);
+            REQUIRE(arr[2] == 3);
+            REQUIRE_FALSE(HugePageResource::is_mapped(arr.size() * sizeof(int)));
+        }
+    }
+
+    SECTION("large blocks are huge page aligned")
+    {
+        for (auto mode : modes)
+        {
+            HugePageResource huge_pages{mode};
+            const size_t size = 3 * HugePageResource::huge_page_size / sizeof(int) + 5;
+
+            FastArray arr(size, &huge_pages);
+            REQUIRE(all_equal(arr.data(), arr.size(), 0));
+
+            if (HugePageResource::is_mapped(size * sizeof(int)))
+                REQUIRE(reinterpret_cast<uintptr_t>(arr.data()) % HugePageResource::huge_page_size == 0);
+
+            arr.iota();
+            REQUIRE(arr[size - 1] == static_cast<int>(size - 1));
+        }
+    }
+
+    SECTION("resources with the same upstream are interchangeable")
+    {
+        HugePageResource huge_pages{HugePageResource::Mode::huge_tlb};
+        HugePageResource other{HugePageResource::Mode::transparent};
+        REQUIRE(huge_pages.is_equal(other));
+        REQUIRE_FALSE(huge_pages.is_equal(*std::pmr::new_delete_resource()));
+
+        FastArray source(HugePageResource::huge_page_size, &other);
+        FastArray target(10, &huge_pages);
+        const int* items = source.data();
+
+        target = std::move(source);
+        REQUIRE(target.data() == items);
+    }
+}
+
+TEST_CASE("parallel_first_touch")
+{
+    HugePageResource huge_pages;
+
+    for (size_t size : {size_t{0}, size_t{100}, 5 * HugePageResource::huge_page_size / sizeof(int) + 3})
+    {
+        for (unsigned int thread_count : {1U, 2U, 3U, 16U})
+        {
+            FastArray arr(size, uninitialized, &huge_pages);
+            parallel_first_touch(arr.data(), arr.size(), 7, thread_count);
+
+            REQUIRE(all_equal(arr.data(), arr.size(), 7));
+        }
+    }
+}
+
+// init - allocation + first touch of every page, scan - sum of initialized items
+TEST_CASE("HugePageResource - init & scan benchmark", "[.benchmark]")
+{
+    constexpr size_t size = 256 * 1024 * 1024 / sizeof(int);
+    const unsigned int thread_count = std::max(2U, std::thread::hardware_concurrency());
+
+    HugePageResource transparent_huge_pages{HugePageResource::Mode::transparent};
+    HugePageResource huge_tlb_pages{HugePageResource::Mode::huge_tlb};
+
+    BENCHMARK("init - new int[] + fill")
+    {
+        std::unique_ptr<int[]> items{new int[size]};
+        std::fill_n(items.get(), size, 1);
+        return items[size - 1];
+    };
+
+    BENCHMARK("init - transparent huge pages + fill")
+    {
+        FastArray arr(size, uninitialized, &transparent_huge_pages);
+        arr.fill(1);
+        return arr[size - 1];
+    };
+
+    BENCHMARK("init - MAP_HUGETLB + fill")
+    {
+        FastArray arr(size, uninitialized, &huge_tlb_pages);
+        arr.fill(1);
+        return arr[size - 1];
+    };
+
+    BENCHMARK("init - transparent huge pages + parallel first touch")
+    {
+        FastArray arr(size, uninitialized, &transparent_huge_pages);
+        parallel_first_touch(arr.data(), arr.size(), 1, thread_count);
+        return arr[size - 1];
+    };
+
+    std::unique_ptr<int[]> items{new int[size]};
+    std::fill_n(items.get(), size, 1);
+
+    FastArray huge_page_items(size, uninitialized, &transparent_huge_pages);
+    parallel_first_touch(huge_page_items.data(), huge_page_items.size(), 1, thread_count);
+
+    BENCHMARK("scan - new int[]")
+    {
+        return Simd::sum(items.get(), size);
+    };
+
+    BENCHMARK("scan - transparent huge pages")
+    {
+        return huge_page_items.sum();
+    };
+}
@@ -0,0 +1,150 @@
+#ifndef HUGE_PAGES_HPP
+#define HUGE_PAGES_HPP
+
+#include "array_simd.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+// memory resource for large arrays - blocks of at least half a huge page are mmap'ed directly:
+// Mode::huge_tlb asks for reserved huge pages (MAP_HUGETLB) and falls back to transparent huge pages,
+// Mode::transparent maps 2 MB aligned memory advised with MADV_HUGEPAGE;
+// smaller blocks (and every block on systems without mmap) come from the upstream resource
+class HugePageResource : public std::pmr::memory_resource
+{
+public:
+    enum class Mode
+    {
+        transparent,
+        huge_tlb
+    };
+
+    static constexpr size_t huge_page_size = 2 * 1024 * 1024;
+
+    explicit HugePageResource(Mode mode = Mode::transparent, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : mode_{mode}
+        , upstream_{upstream}
+    {
+    }
+
+    Mode mode() const noexcept
+    {
+        return mode_;
+    }
+
+    static bool is_mapped(size_t bytes) noexcept
+    {
+#ifdef __linux__
+        return bytes >= huge_page_size / 2;
+#else
+        return false;
+#endif
+    }
+
+private:
+    Mode mode_;
+    std::pmr::memory_resource* upstream_;
+
+    static size_t mapped_size(size_t bytes) noexcept
+    {
+        return (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+    }
+
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        assert(alignment <= huge_page_size);
+
+        if (!is_mapped(bytes))
+            return upstream_->allocate(bytes, alignment);
+
+#ifdef __linux__
+        const size_t size = mapped_size(bytes);
+
+#ifdef MAP_HUGETLB
+        if (mode_ == Mode::huge_tlb)
+        {
+            void* ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (ptr != MAP_FAILED)
+                return ptr;
+        }
+#endif
+
+        // over-map by one huge page and trim both ends, so the block starts at a huge page boundary
+        void* ptr = ::mmap(nullptr, size + huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED)
+            throw std::bad_alloc{};
+
+        const uintptr_t start = reinterpret_cast<uintptr_t>(ptr);
+        const uintptr_t aligned_start = (start + huge_page_size - 1) / huge_page_size * huge_page_size;
+
+        if (aligned_start > start)
+            ::munmap(ptr, aligned_start - start);
+        ::munmap(reinterpret_cast<void*>(aligned_start + size), start + huge_page_size - aligned_start);
+
+#ifdef MADV_HUGEPAGE
+        ::madvise(reinterpret_cast<void*>(aligned_start), size, MADV_HUGEPAGE);
+#endif
+
+        return reinterpret_cast<void*>(aligned_start);
+#else
+        return nullptr; // unreachable - is_mapped() is false
+#endif
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override
+    {
+        if (!is_mapped(bytes))
+            return upstream_->deallocate(ptr, bytes, alignment);
+
+#ifdef __linux__
+        ::munmap(ptr, mapped_size(bytes));
+#endif
+    }
+
+    // blocks are released with munmap or by the upstream - any HugePageResource with the same upstream can free them
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        const auto* other_resource = dynamic_cast<const HugePageResource*>(&other);
+        return other_resource && upstream_->is_equal(*other_resource->upstream_);
+    }
+};
+
+// first touch decides on which NUMA node a page is placed - every thread fills its own
+// contiguous, huge page aligned part, so pages are spread over the nodes the threads run on
+inline void parallel_first_touch(int* items, size_t size, int value, unsigned int thread_count = std::thread::hardware_concurrency())
+{
+    constexpr size_t items_per_page = HugePageResource::huge_page_size / sizeof(int);
+
+    const size_t pages = (size + items_per_page - 1) / items_per_page;
+    thread_count = static_cast<unsigned int>(std::clamp<size_t>(thread_count, 1, std::max<size_t>(pages, 1)));
+
+    const size_t pages_per_thread = (pages + thread_count - 1) / thread_count;
+    const size_t chunk_size = pages_per_thread * items_per_page;
+
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count - 1);
+
+    for (unsigned int i = 1; i < thread_count; ++i)
+    {
+        const size_t first = std::min(size, i * chunk_size);
+        const size_t last = std::min(size, first + chunk_size);
+        threads.emplace_back([=] { Simd::fill(items + first, last - first, value); });
+    }
+
+    Simd::fill(items, std::min(size, chunk_size), value);
+
+    for (auto& t : threads)
+        t.join();
+}
+
+#endif
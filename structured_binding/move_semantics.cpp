@@ -1,11 +1,18 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "accounting.hpp"
+#include "array.hpp"
+
 #include <algorithm>
 #include <array>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <iostream>
 #include <list>
 #include <map>
+#include <memory_resource>
 #include <numeric>
+#include <sstream>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -58,156 +65,147 @@ TEST_CASE("binding refs")
     }
 }
 
-//////////////////////////////////////////////
-// Array with move semantics
-
-class Array
+TEST_CASE("Array - dynamic array")
 {
-    int* items_;
-    size_t size_;
+    Array arr_1 = {1, 2, 3, 4};
+    REQUIRE(arr_1.size() == 4);
+    REQUIRE(arr_1[0] == 1);
+    REQUIRE(arr_1[3] == 4);
 
-public:
-    Array(size_t size)
-        : items_{new int[size]}
-        , size_{size}
-    {
-        std::fill_n(items_, size_, 0);
+    Array arr_2 = arr_1; // copy
+    REQUIRE(arr_1.data() != arr_2.data());
+    REQUIRE(arr_2.size() == 4);
+    REQUIRE(arr_2[0] == 1);
+    REQUIRE(arr_2[3] == 4);
 
-        std::cout << "Array(size: " << size_ << ", @" << items_ << ")\n";
+    int* ptr = arr_1.data();
+    Array arr_3 = std::move(arr_1);
+    REQUIRE(arr_3.data() == ptr);
+    REQUIRE(arr_3.size() == 4);
+    REQUIRE(arr_3[0] == 1);
+    REQUIRE(arr_3[3] == 4);
+}
+
+TEST_CASE("Array - memory resources")
+{
+    SECTION("uninitialized items")
+    {
+        Array arr(100, uninitialized);
+        REQUIRE(arr.size() == 100);
+        std::iota(arr.data(), arr.data() + arr.size(), 0);
+        REQUIRE(arr[99] == 99);
     }
 
-    Array(std::initializer_list<int> il)
-        : items_{new int[il.size()]}
-        , size_{il.size()}
+    SECTION("default resource")
     {
-        std::copy(il.begin(), il.end(), items_);
-        std::cout << "Array({ ";
-        for (const auto& item : il)
-            std::cout << item << " ";
-        std::cout << "}"
-                  << ", @" << items_ << ")\n";
+        Array arr(4);
+        REQUIRE(arr.resource() == std::pmr::get_default_resource());
+        REQUIRE(std::all_of(arr.data(), arr.data() + arr.size(), [](int x) { return x == 0; }));
     }
 
-    // copy constructor
-    Array(const Array& source)
-        : items_{new int[source.size()]}
-        , size_{source.size()}
+    SECTION("items allocated from given resource")
     {
-        std::cout << "Array(cc: { ";
-        for (size_t i = 0; i < source.size(); ++i)
+        std::array<std::byte, 1024> buffer;
+        std::pmr::monotonic_buffer_resource arena{buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+
+        Array arr({1, 2, 3}, &arena);
+        REQUIRE(arr.resource() == &arena);
+        REQUIRE(reinterpret_cast<std::byte*>(arr.data()) >= buffer.data());
+        REQUIRE(reinterpret_cast<std::byte*>(arr.data()) < buffer.data() + buffer.size());
+
+        SECTION("move keeps resource")
         {
-            items_[i] = source[i];
-            std::cout << items_[i] << " ";
+            Array target = std::move(arr);
+            REQUIRE(target.resource() == &arena);
+            REQUIRE(target[2] == 3);
         }
-        std::cout << "}"
-                  << ", @" << items_ << ")\n";
-    }
 
-    // copy assignment
-    Array& operator=(const Array& source)
-    {
-        if (this != &source)
+        SECTION("copy uses default resource")
         {
-            delete[] items_;
-
-            items_ = new int[source.size()];
-            size_ = source.size();
-
-            std::cout << "Array::operator=(cc: { ";
-            for (size_t i = 0; i < source.size(); ++i)
-            {
-                items_[i] = source[i];
-                std::cout << items_[i] << " ";
-            }
-            std::cout << "}"
-                      << ", @" << items_ << ")\n";
+            Array copy = arr;
+            REQUIRE(copy.resource() == std::pmr::get_default_resource());
+            REQUIRE(copy[2] == 3);
         }
 
-        return *this;
+        SECTION("move assignment across resources copies items")
+        {
+            Array target{7, 8};
+            target = std::move(arr);
+            REQUIRE(target.resource() == std::pmr::get_default_resource());
+            REQUIRE(target.size() == 3);
+            REQUIRE(target[0] == 1);
+        }
     }
 
-    // move constructor
-    Array(Array&& source) noexcept
-        : items_{source.items_}
-        , size_{source.size_}
+    SECTION("pool reuses freed blocks")
     {
-        source.items_ = nullptr;
-        source.size_ = 0;
-
-        std::cout << "Array(mv: @" << items_ << ")\n";
-    }
+        std::pmr::unsynchronized_pool_resource pool;
 
-    // move assignment
-    Array& operator=(Array&& source)
-    {
-        if (this != &source)
+        int* first_items;
         {
-            delete[] items_;
-
-            items_ = std::move(source.items_);
-            size_ = std::move(source.size_);
-
-            source.items_ = nullptr;
-            source.size_ = 0;
-
-            std::cout << "Array::operator=(mv: @" << items_ << ")\n";
+            Array arr(64, uninitialized, &pool);
+            first_items = arr.data();
         }
 
-        return *this;
+        Array arr(64, uninitialized, &pool);
+        REQUIRE(arr.data() == first_items);
     }
+}
 
-    ~Array()
+TEST_CASE("Array - trace policies")
+{
+    SECTION("NoTrace - no state, no output")
     {
-        std::cout << "~Array(@";
-        if (items_)
-            std::cout << items_;
-        else
-            std::cout << "nullptr - state after move";
-        std::cout << ")\n";
+        static_assert(sizeof(BasicArray<NoTrace>) == sizeof(Array));
 
-        delete[] items_;
-    }
+        std::ostringstream out;
+        std::streambuf* original = std::cout.rdbuf(out.rdbuf());
+        {
+            BasicArray<NoTrace> arr = {1, 2, 3};
+            BasicArray<NoTrace> copy = arr;
+        }
+        std::cout.rdbuf(original);
 
-    size_t size() const
-    {
-        return size_;
+        REQUIRE(out.str().empty());
     }
 
-    int* data() const
+    SECTION("CountingTrace")
     {
-        return items_;
-    }
+        CountingTrace::reset();
+        {
+            std::vector<BasicArray<CountingTrace>> dataset;
+            dataset.reserve(2);
 
-    int& operator[](size_t index)
-    {
-        return items_[index];
-    }
+            BasicArray<CountingTrace> arr(10);
+            dataset.push_back(std::move(arr));
+            dataset.push_back(dataset.front());
+            arr = std::move(dataset.back());
+        }
 
-    const int& operator[](size_t index) const
-    {
-        return items_[index];
+        const TraceCounters& counters = CountingTrace::counters;
+        REQUIRE(counters.constructions == 1);
+        REQUIRE(counters.copy_constructions == 1);
+        REQUIRE(counters.move_constructions == 1);
+        REQUIRE(counters.move_assignments == 1);
+        REQUIRE(counters.copy_assignments == 0);
+        REQUIRE(counters.destructions == 3);
     }
-};
 
-TEST_CASE("Array - dynamic array")
-{
-    Array arr_1 = {1, 2, 3, 4};
-    REQUIRE(arr_1.size() == 4);
-    REQUIRE(arr_1[0] == 1);
-    REQUIRE(arr_1[3] == 4);
-
-    Array arr_2 = arr_1; // copy
-    REQUIRE(arr_1.data() != arr_2.data());
-    REQUIRE(arr_2.size() == 4);
-    REQUIRE(arr_2[0] == 1);
-    REQUIRE(arr_2[3] == 4);
+    SECTION("FullTrace")
+    {
+        std::ostringstream out;
+        std::streambuf* original = std::cout.rdbuf(out.rdbuf());
+        {
+            Array arr = {1, 2};
+            Array copy = arr;
+        }
+        std::cout.rdbuf(original);
 
-    int* ptr = arr_1.data();
-    Array arr_3 = std::move(arr_1);
-    REQUIRE(arr_3.data() == ptr);
-    REQUIRE(arr_3.size() == 4);
-    REQUIRE(arr_3[0] == 1);
-    REQUIRE(arr_3[3] == 4);
+        const std::string log = out.str();
+        REQUIRE(log.find("Array({ 1 2 }, @") == 0);
+        REQUIRE(log.find("Array(cc: { 1 2 }, @") != std::string::npos);
+        REQUIRE(log.find("~Array(@") != std::string::npos);
+    }
 }
 
 TEST_CASE("move")
@@ -237,7 +235,7 @@ namespace Legacy
 {
     Array* load_big_data()
     {
-        Array* data = new Array(1'000'000);
+        Array* data = new Array(1'000'000, uninitialized);
         for (size_t i = 0; i < data->size(); ++i)
         {
             (*data)[i] = i;
@@ -249,9 +247,10 @@ namespace Legacy
 
 namespace Modern
 {
-    Array load_big_data()
+    template <typename TArray = Array>
+    TArray load_big_data()
     {
-        Array data(10);
+        TArray data(10, uninitialized);
         for (size_t i = 0; i < data.size(); ++i)
         {
             data[i] = i;
@@ -274,6 +273,70 @@ TEST_CASE("modern cpp with move semantics")
     dataset.push_back(Array{1, 2, 3, 4, 5});
 }
 
+TEST_CASE("modern cpp with move semantics - accounting")
+{
+    using TrackedArray = BasicArray<Accounting::AccountingTrace>;
+
+    std::vector<TrackedArray> dataset;
+    dataset.reserve(4);
+
+    SECTION("returned value pushed to vector - zero copies")
+    {
+        Accounting::Scope scope;
+        dataset.push_back(Modern::load_big_data<TrackedArray>());
+        const Accounting::Counters delta = scope.delta();
+
+        REQUIRE(delta.copies() == 0);
+        REQUIRE(delta.move_constructions == 1);
+        REQUIRE(delta.allocations == 1);
+        REQUIRE(delta.bytes_allocated == 10 * sizeof(int));
+    }
+
+    SECTION("lvalue pushed to vector - one copy")
+    {
+        TrackedArray data = Modern::load_big_data<TrackedArray>();
+
+        Accounting::Scope scope;
+        dataset.push_back(data);
+        const Accounting::Counters delta = scope.delta();
+
+        REQUIRE(delta.copy_constructions == 1);
+        REQUIRE(delta.moves() == 0);
+        REQUIRE(delta.allocations == 1);
+    }
+
+    SECTION("vector growth relocates by move")
+    {
+        for (int i = 0; i < 4; ++i)
+            dataset.push_back(Modern::load_big_data<TrackedArray>());
+
+        Accounting::Scope scope;
+        dataset.push_back(Modern::load_big_data<TrackedArray>());
+        const Accounting::Counters delta = scope.delta();
+
+        REQUIRE(delta.copies() == 0);
+        REQUIRE(delta.move_constructions == 5); // 4 relocated + 1 pushed
+    }
+
+    SECTION("Tracked wrapper")
+    {
+        std::vector<Accounting::Tracked<std::string>> words;
+        words.reserve(2);
+
+        Accounting::Scope scope;
+        words.emplace_back(std::in_place, 100, 'a');
+        Accounting::Tracked<std::string> word{"text"s};
+        words.push_back(std::move(word));
+        words[0] = words[1];
+        const Accounting::Counters delta = scope.delta();
+
+        REQUIRE(delta.copy_constructions == 0);
+        REQUIRE(delta.move_constructions == 1);
+        REQUIRE(delta.copy_assignments == 1);
+        REQUIRE(words[0].get() == "text");
+    }
+}
+
 namespace TwoVersions
 {
     void use(Array&& arr)
@@ -341,3 +404,119 @@ TEST_CASE("forwarding")
 
     std::cout << data2[0] << "\n";
 }
+
+namespace
+{
+    class NullBuffer : public std::streambuf
+    {
+    protected:
+        int overflow(int c) override
+        {
+            return c;
+        }
+
+        std::streamsize xsputn(const char*, std::streamsize count) override
+        {
+            return count;
+        }
+    };
+
+    // Array logs every lifecycle event - benchmarks discard the output
+    class SilentCout
+    {
+        NullBuffer null_buffer_;
+        std::streambuf* original_;
+
+    public:
+        SilentCout()
+            : original_{std::cout.rdbuf(&null_buffer_)}
+        {
+        }
+
+        SilentCout(const SilentCout&) = delete;
+        SilentCout& operator=(const SilentCout&) = delete;
+
+        ~SilentCout()
+        {
+            std::cout.rdbuf(original_);
+        }
+    };
+}
+
+TEST_CASE("Array - construct/destroy churn", "[.benchmark]")
+{
+    using Array = BasicArray<NoTrace>;
+
+    std::pmr::unsynchronized_pool_resource pool;
+
+    for (size_t size : {16, 256, 4096, 65536})
+    {
+        const std::string suffix = " - size: " + std::to_string(size);
+
+        BENCHMARK("default resource + zero fill" + suffix)
+        {
+            Array arr(size);
+            return arr.data()[size - 1];
+        };
+
+        BENCHMARK("default resource + uninitialized" + suffix)
+        {
+            Array arr(size, uninitialized);
+            arr[size - 1] = 1;
+            return arr.data()[size - 1];
+        };
+
+        BENCHMARK("pool + zero fill" + suffix)
+        {
+            Array arr(size, &pool);
+            return arr.data()[size - 1];
+        };
+
+        BENCHMARK("pool + uninitialized" + suffix)
+        {
+            Array arr(size, uninitialized, &pool);
+            arr[size - 1] = 1;
+            return arr.data()[size - 1];
+        };
+    }
+}
+
+namespace
+{
+    template <typename TArray>
+    size_t grow_dataset(size_t count, size_t array_size)
+    {
+        std::vector<TArray> dataset;
+        for (size_t i = 0; i < count; ++i)
+            dataset.push_back(TArray(array_size));
+        return dataset.size();
+    }
+}
+
+TEST_CASE("Array - trace policy overhead", "[.benchmark]")
+{
+    constexpr size_t count = 10'000;
+    constexpr size_t array_size = 16;
+
+    BENCHMARK("std::vector<std::pmr::vector<int>> - baseline")
+    {
+        return grow_dataset<std::pmr::vector<int>>(count, array_size);
+    };
+
+    BENCHMARK("std::vector<BasicArray<NoTrace>>")
+    {
+        return grow_dataset<BasicArray<NoTrace>>(count, array_size);
+    };
+
+    BENCHMARK("std::vector<BasicArray<CountingTrace>>")
+    {
+        return grow_dataset<BasicArray<CountingTrace>>(count, array_size);
+    };
+
+    SilentCout silent_cout;
+
+    BENCHMARK("std::vector<BasicArray<FullTrace>> - output discarded")
+    {
+        return grow_dataset<BasicArray<FullTrace>>(count, array_size);
+    };
+}
@@ -0,0 +1,188 @@
+#ifndef RELOCATING_VECTOR_HPP
+#define RELOCATING_VECTOR_HPP
+
+#include "array.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// type can be moved to another address by copying its bytes (the source is not destroyed afterwards)
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T>
+{
+};
+
+// owns its items through a pointer - no self-references (trace hooks are not called on relocation)
+template <typename TTrace>
+struct is_trivially_relocatable<BasicArray<TTrace>> : std::true_type
+{
+};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+// growable array for trivially relocatable types - growth is a single realloc
+// (large blocks are often extended in place), no move constructor runs
+template <typename T>
+class RelocatingVector
+{
+    static_assert(is_trivially_relocatable_v<T>, "items are relocated with realloc");
+    static_assert(alignof(T) <= alignof(std::max_align_t), "realloc guarantees only fundamental alignment");
+
+    T* data_{};
+    size_t size_{};
+    size_t capacity_{};
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    RelocatingVector() noexcept = default;
+
+    RelocatingVector(const RelocatingVector&) = delete;
+    RelocatingVector& operator=(const RelocatingVector&) = delete;
+
+    RelocatingVector(RelocatingVector&& other) noexcept
+        : data_{std::exchange(other.data_, nullptr)}
+        , size_{std::exchange(other.size_, 0)}
+        , capacity_{std::exchange(other.capacity_, 0)}
+    {
+    }
+
+    RelocatingVector& operator=(RelocatingVector&& other) noexcept
+    {
+        RelocatingVector temp(std::move(other));
+        std::swap(data_, temp.data_);
+        std::swap(size_, temp.size_);
+        std::swap(capacity_, temp.capacity_);
+        return *this;
+    }
+
+    ~RelocatingVector()
+    {
+        clear();
+        std::free(data_);
+    }
+
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    void reserve(size_t new_capacity)
+    {
+        if (new_capacity <= capacity_)
+            return;
+
+        void* new_data = std::realloc(static_cast<void*>(data_), new_capacity * sizeof(T));
+        if (!new_data)
+            throw std::bad_alloc{};
+
+        data_ = static_cast<T*>(new_data);
+        capacity_ = new_capacity;
+    }
+
+    template <typename... TArgs>
+    T& emplace_back(TArgs&&... args)
+    {
+        if (size_ == capacity_)
+        {
+            // args may refer to items that are about to be relocated -
+            // the item is built aside and then relocated bitwise like the others
+            alignas(T) unsigned char buffer[sizeof(T)];
+            T* item = ::new (static_cast<void*>(buffer)) T(std::forward<TArgs>(args)...);
+
+            try
+            {
+                reserve(capacity_ ? 2 * capacity_ : 1);
+            }
+            catch (...)
+            {
+                item->~T();
+                throw;
+            }
+
+            std::memcpy(static_cast<void*>(data_ + size_), buffer, sizeof(T));
+        }
+        else
+        {
+            ::new (static_cast<void*>(data_ + size_)) T(std::forward<TArgs>(args)...);
+        }
+
+        return *std::launder(data_ + size_++);
+    }
+
+    void push_back(const T& item)
+    {
+        emplace_back(item);
+    }
+
+    void push_back(T&& item)
+    {
+        emplace_back(std::move(item));
+    }
+
+    void clear() noexcept
+    {
+        std::destroy(begin(), end());
+        size_ = 0;
+    }
+
+    T* data() noexcept
+    {
+        return data_;
+    }
+
+    const T* data() const noexcept
+    {
+        return data_;
+    }
+
+    T& operator[](size_t index) noexcept
+    {
+        return data_[index];
+    }
+
+    const T& operator[](size_t index) const noexcept
+    {
+        return data_[index];
+    }
+
+    iterator begin() noexcept
+    {
+        return data_;
+    }
+
+    iterator end() noexcept
+    {
+        return data_ + size_;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return data_;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return data_ + size_;
+    }
+};
+
+#endif
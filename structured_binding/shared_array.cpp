@@ -0,0 +1,178 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "array.hpp"
+#include "shared_array.hpp"
+
+#include <atomic>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+TEST_CASE("SharedArray")
+{
+    SharedArray arr = {1, 2, 3, 4};
+    REQUIRE(arr.size() == 4);
+    REQUIRE(arr.is_unique());
+
+    SECTION("copy shares items")
+    {
+        SharedArray copy = arr;
+        REQUIRE(copy.data() == arr.data());
+        REQUIRE(arr.use_count() == 2);
+    }
+
+    SECTION("write detaches the copy")
+    {
+        SharedArray copy = arr;
+        copy.set(0, 100);
+
+        REQUIRE(copy.data() != arr.data());
+        REQUIRE(copy[0] == 100);
+        REQUIRE(arr[0] == 1);
+        REQUIRE(copy[3] == 4);
+        REQUIRE(arr.is_unique());
+        REQUIRE(copy.is_unique());
+    }
+
+    SECTION("write to unique array - no copy")
+    {
+        const int* items = arr.data();
+        arr.set(1, 20);
+        REQUIRE(arr.data() == items);
+        REQUIRE(arr[1] == 20);
+    }
+
+    SECTION("move")
+    {
+        const int* items = arr.data();
+        SharedArray target = std::move(arr);
+        REQUIRE(target.data() == items);
+        REQUIRE(arr.size() == 0);
+        REQUIRE(arr.use_count() == 0);
+        REQUIRE(arr.mutable_data() == nullptr);
+    }
+
+    SECTION("assignment releases previous block")
+    {
+        SharedArray other(10);
+        SharedArray copy = other;
+        other = arr;
+
+        REQUIRE(copy.is_unique());
+        REQUIRE(other.data() == arr.data());
+        REQUIRE(arr.use_count() == 2);
+    }
+
+    SECTION("from Array")
+    {
+        BasicArray<NoTrace> source(100, uninitialized);
+        source.iota();
+
+        SharedArray shared{source};
+        REQUIRE(shared.size() == 100);
+        REQUIRE(shared[99] == 99);
+    }
+}
+
+TEST_CASE("SharedArray - concurrent readers & writers")
+{
+    constexpr size_t size = 1000;
+    constexpr int copies_per_thread = 200;
+    const unsigned int thread_count = std::max(4U, std::thread::hardware_concurrency());
+
+    SharedArray origin(size, uninitialized);
+    std::iota(origin.mutable_data(), origin.mutable_data() + size, 0);
+    const int64_t expected_sum = int64_t{size} * (size - 1) / 2;
+
+    std::atomic<int> errors{};
+    std::vector<std::thread> consumers;
+
+    for (unsigned int i = 0; i < thread_count; ++i)
+    {
+        consumers.emplace_back([&errors, copy = origin, i, expected_sum]() mutable {
+            for (int j = 0; j < copies_per_thread; ++j)
+            {
+                SharedArray local = copy;
+
+                if (Simd::sum(local.data(), local.size()) != expected_sum)
+                    ++errors;
+
+                if ((i + j) % 2 == 0)
+                {
+                    local.set(0, -1); // detaches from the shared block
+                    if (local[0] != -1 || copy[0] != 0)
+                        ++errors;
+                }
+            }
+        });
+    }
+
+    for (auto& t : consumers)
+        t.join();
+
+    REQUIRE(errors == 0);
+    REQUIRE(origin.is_unique());
+    REQUIRE(Simd::sum(origin.data(), origin.size()) == expected_sum);
+}
+
+// fan-out - every consumer keeps its own copy of a 4 MB array and reads a few items
+TEST_CASE("SharedArray - fan-out benchmark", "[.benchmark]")
+{
+    constexpr size_t size = 1024 * 1024;
+
+    BasicArray<NoTrace> array(size);
+    array.iota();
+    const SharedArray shared{array};
+
+    for (size_t consumers : {1, 4, 16, 64})
+    {
+        const std::string suffix = " - " + std::to_string(consumers) + " consumers";
+
+        BENCHMARK("deep copy of Array" + suffix)
+        {
+            std::vector<BasicArray<NoTrace>> copies;
+            copies.reserve(consumers);
+            for (size_t i = 0; i < consumers; ++i)
+                copies.push_back(array);
+
+            int64_t result{};
+            for (const auto& copy : copies)
+                result += copy[copy.size() / 2];
+            return result;
+        };
+
+        BENCHMARK("SharedArray" + suffix)
+        {
+            std::vector<SharedArray> copies;
+            copies.reserve(consumers);
+            for (size_t i = 0; i < consumers; ++i)
+                copies.push_back(shared);
+
+            int64_t result{};
+            for (const auto& copy : copies)
+                result += copy[copy.size() / 2];
+            return result;
+        };
+
+        BENCHMARK("SharedArray - every consumer writes" + suffix)
+        {
+            std::vector<SharedArray> copies;
+            copies.reserve(consumers);
+            for (size_t i = 0; i < consumers; ++i)
+                copies.push_back(shared);
+
+            int64_t result{};
+            for (auto& copy : copies)
+            {
+                copy.set(0, 1);
+                result += copy[copy.size() / 2];
+            }
+            return result;
+        };
+    }
+}
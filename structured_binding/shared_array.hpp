@@ -0,0 +1,161 @@
+#ifndef SHARED_ARRAY_HPP
+#define SHARED_ARRAY_HPP
+
+#include "array.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <utility>
+
+// copy-on-write array - copies share one reference-counted block, the first write through
+// a copy that isn't the only owner detaches it (deep copy);
+// like shared_ptr: different SharedArray objects may be used from different threads,
+// one object must not be modified concurrently
+class SharedArray
+{
+    struct alignas(32) Block
+    {
+        std::atomic<size_t> ref_count;
+        size_t size;
+
+        int* items() noexcept
+        {
+            return reinterpret_cast<int*>(this + 1);
+        }
+    };
+
+    static_assert(sizeof(Block) % alignof(Block) == 0);
+
+    Block* block_;
+
+    static Block* create(size_t size)
+    {
+        void* memory = ::operator new(sizeof(Block) + size * sizeof(int), std::align_val_t{alignof(Block)});
+        return ::new (memory) Block{{1}, size};
+    }
+
+    static void release(Block* block) noexcept
+    {
+        if (block && block->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            block->~Block();
+            ::operator delete(block, std::align_val_t{alignof(Block)});
+        }
+    }
+
+    void detach()
+    {
+        if (is_unique())
+            return;
+
+        Block* copy = create(block_->size);
+        Simd::copy(copy->items(), block_->items(), block_->size);
+        release(std::exchange(block_, copy));
+    }
+
+public:
+    SharedArray(size_t size, Uninitialized)
+        : block_{create(size)}
+    {
+    }
+
+    explicit SharedArray(size_t size)
+        : SharedArray(size, uninitialized)
+    {
+        Simd::fill(block_->items(), size, 0);
+    }
+
+    SharedArray(std::initializer_list<int> il)
+        : SharedArray(il.size(), uninitialized)
+    {
+        std::copy(il.begin(), il.end(), block_->items());
+    }
+
+    template <typename TTrace>
+    explicit SharedArray(const BasicArray<TTrace>& source)
+        : SharedArray(source.size(), uninitialized)
+    {
+        Simd::copy(block_->items(), source.data(), source.size());
+    }
+
+    // O(1) - only the reference count is incremented
+    SharedArray(const SharedArray& other) noexcept
+        : block_{other.block_}
+    {
+        if (block_)
+            block_->ref_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    SharedArray& operator=(const SharedArray& other) noexcept
+    {
+        SharedArray temp(other);
+        std::swap(block_, temp.block_);
+        return *this;
+    }
+
+    SharedArray(SharedArray&& other) noexcept
+        : block_{std::exchange(other.block_, nullptr)}
+    {
+    }
+
+    SharedArray& operator=(SharedArray&& other) noexcept
+    {
+        SharedArray temp(std::move(other));
+        std::swap(block_, temp.block_);
+        return *this;
+    }
+
+    ~SharedArray()
+    {
+        release(block_);
+    }
+
+    size_t size() const noexcept
+    {
+        return block_ ? block_->size : 0;
+    }
+
+    size_t use_count() const noexcept
+    {
+        return block_ ? block_->ref_count.load(std::memory_order_relaxed) : 0;
+    }
+
+    // acquire pairs with the release in other owners' decrements - their reads are finished
+    bool is_unique() const noexcept
+    {
+        return block_ && block_->ref_count.load(std::memory_order_acquire) == 1;
+    }
+
+    const int* data() const noexcept
+    {
+        return block_ ? block_->items() : nullptr;
+    }
+
+    const int& operator[](size_t index) const noexcept
+    {
+        assert(index < size());
+        return block_->items()[index];
+    }
+
+    // write access - detaches from other owners; the pointer is valid until this object is copied
+    int* mutable_data()
+    {
+        if (!block_)
+            return nullptr;
+
+        detach();
+        return block_->items();
+    }
+
+    void set(size_t index, int value)
+    {
+        assert(index < size());
+        mutable_data()[index] = value;
+    }
+};
+
+#endif
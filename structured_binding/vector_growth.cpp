@@ -0,0 +1,217 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "array.hpp"
+#include "relocating_vector.hpp"
+
+#include <algorithm>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+    using FastArray = BasicArray<NoTrace>;
+
+    // move constructor not marked noexcept - std::vector copies items when it grows
+    class ThrowingMoveArray : public FastArray
+    {
+    public:
+        using FastArray::FastArray;
+
+        ThrowingMoveArray(const ThrowingMoveArray&) = default;
+        ThrowingMoveArray& operator=(const ThrowingMoveArray&) = default;
+        ThrowingMoveArray& operator=(ThrowingMoveArray&&) = default;
+
+        ThrowingMoveArray(ThrowingMoveArray&& source) noexcept(false)
+            : FastArray(std::move(source))
+        {
+        }
+    };
+
+    static_assert(std::is_nothrow_move_constructible_v<FastArray>);
+    static_assert(!std::is_nothrow_move_constructible_v<ThrowingMoveArray>);
+}
+
+TEST_CASE("RelocatingVector")
+{
+    using CountedArray = BasicArray<CountingTrace>;
+
+    CountingTrace::reset();
+    {
+        RelocatingVector<CountedArray> vec;
+        for (int i = 0; i < 100; ++i)
+            vec.push_back(CountedArray{i, i + 1});
+
+        REQUIRE(vec.size() == 100);
+        REQUIRE(vec.capacity() >= 100);
+        REQUIRE(vec[0][0] == 0);
+        REQUIRE(vec[99][1] == 100);
+
+        SECTION("growth doesn't move items")
+        {
+            REQUIRE(CountingTrace::counters.move_constructions == 100); // only into the vector
+        }
+
+        SECTION("move of vector keeps items")
+        {
+            const int* items = vec[50].data();
+
+            RelocatingVector<CountedArray> target = std::move(vec);
+            REQUIRE(vec.empty());
+            REQUIRE(target.size() == 100);
+            REQUIRE(target[50].data() == items);
+        }
+
+        SECTION("emplace_back of own item into full vector")
+        {
+            while (vec.size() < vec.capacity())
+                vec.push_back(CountedArray{-1, -1});
+
+            const size_t full_capacity = vec.capacity();
+            const size_t copies = CountingTrace::counters.copy_constructions;
+
+            vec.emplace_back(vec[0]); // vec[0] is relocated by the growth
+
+            REQUIRE(vec.capacity() > full_capacity);
+            REQUIRE(CountingTrace::counters.copy_constructions == copies + 1);
+            REQUIRE(vec[full_capacity][0] == 0);
+            REQUIRE(vec[full_capacity][1] == 1);
+            REQUIRE(vec[0][1] == 1);
+        }
+
+        SECTION("emplace_back of own item - first growth")
+        {
+            RelocatingVector<CountedArray> single;
+            single.reserve(1);
+            single.push_back(CountedArray{7, 8});
+
+            single.emplace_back(single[0]);
+
+            REQUIRE(single.capacity() == 2);
+            REQUIRE(single[1][0] == 7);
+            REQUIRE(single[1][1] == 8);
+        }
+    }
+
+    REQUIRE(CountingTrace::counters.destructions == CountingTrace::counters.constructions
+            + CountingTrace::counters.copy_constructions + CountingTrace::counters.move_constructions);
+}
+
+namespace
+{
+    template <typename TItem>
+    std::vector<TItem> make_items(size_t count)
+    {
+        std::vector<TItem> items;
+        items.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+            items.emplace_back(4, uninitialized);
+
+        return items;
+    }
+
+    // fills an empty container with items moved from source and moves them back,
+    // so every run starts with the same source
+    template <typename TContainer, typename TItem>
+    size_t fill(std::vector<TItem>& source, bool reserve)
+    {
+        TContainer container;
+        if (reserve)
+            container.reserve(source.size());
+
+        for (auto& item : source)
+            container.push_back(std::move(item));
+
+        std::move(container.begin(), container.end(), source.begin());
+
+        return container.size();
+    }
+
+    // best of runs - wall time of one fill in nanoseconds
+    template <typename TContainer, typename TItem>
+    double fill_time_ns(std::vector<TItem>& source, bool reserve, int runs)
+    {
+        double best = std::numeric_limits<double>::max();
+
+        for (int run = 0; run < runs; ++run)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            fill<TContainer>(source, reserve);
+            const auto stop = std::chrono::steady_clock::now();
+
+            best = std::min(best, std::chrono::duration<double, std::nano>(stop - start).count());
+        }
+
+        return best;
+    }
+}
+
+// growth cost of a whole fill - the reserve case has no relocation at all;
+// the difference to it, per item, is reported by the next test case
+TEST_CASE("std::vector<Array> - growth & relocation", "[.benchmark]")
+{
+    for (size_t count : {1'000, 10'000, 100'000, 1'000'000, 10'000'000})
+    {
+        const std::string suffix = " - " + std::to_string(count) + " items";
+
+        auto items = make_items<FastArray>(count);
+        auto throwing_items = make_items<ThrowingMoveArray>(count);
+
+        BENCHMARK("std::vector - noexcept move" + suffix)
+        {
+            return fill<std::vector<FastArray>>(items, false);
+        };
+
+        BENCHMARK("std::vector - throwing move" + suffix)
+        {
+            return fill<std::vector<ThrowingMoveArray>>(throwing_items, false);
+        };
+
+        BENCHMARK("std::vector - reserve" + suffix)
+        {
+            return fill<std::vector<FastArray>>(items, true);
+        };
+
+        BENCHMARK("RelocatingVector - realloc relocate" + suffix)
+        {
+            return fill<RelocatingVector<FastArray>>(items, false);
+        };
+    }
+}
+
+// the reserve fill is the baseline - what a strategy takes above it is relocation,
+// spread over the inserted items
+TEST_CASE("std::vector<Array> - relocation cost per item", "[.benchmark]")
+{
+    std::ostringstream report;
+    report << "relocation cost per inserted item [ns]:\n";
+    report << std::fixed << std::setprecision(2);
+
+    for (size_t count : {1'000, 10'000, 100'000, 1'000'000, 10'000'000})
+    {
+        const int runs = static_cast<int>(std::clamp<size_t>(10'000'000 / count, 3, 1'000));
+
+        auto items = make_items<FastArray>(count);
+        auto throwing_items = make_items<ThrowingMoveArray>(count);
+
+        const double reserve = fill_time_ns<std::vector<FastArray>>(items, true, runs);
+        const double noexcept_move = fill_time_ns<std::vector<FastArray>>(items, false, runs);
+        const double throwing_move = fill_time_ns<std::vector<ThrowingMoveArray>>(throwing_items, false, runs);
+        const double realloc_relocate = fill_time_ns<RelocatingVector<FastArray>>(items, false, runs);
+
+        report << std::setw(10) << count << " items"
+               << " - noexcept move: " << (noexcept_move - reserve) / count
+               << ", throwing move: " << (throwing_move - reserve) / count
+               << ", realloc relocate: " << (realloc_relocate - reserve) / count << "\n";
+    }
+
+    WARN(report.str());
+}